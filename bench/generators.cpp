@@ -0,0 +1,177 @@
+// generators.cpp - Seeded synthetic polygons for the benchmarks and tests
+// Only the generators' own arithmetic and std::mt19937 are used (no
+// std::uniform_real_distribution, which differs between libraries), so
+// a seed gives the same polygon everywhere.
+
+#include <math.h>
+#include <random>
+#include "generators.h"
+
+static const double PI = 3.14159265358979323846;
+
+// uniform(): a random double in [lo, hi)
+static inline double uniform( std::mt19937 &rng, double lo, double hi )
+{
+    return lo + (hi - lo) * (rng() / 4294967296.0);
+}
+
+void gen_Star( Polygon &P, unsigned seed )
+{
+    const double R = 1e6;
+    std::mt19937 rng(seed);
+    for (int i=0; i < P.n; i++) {
+        double a = 2 * PI * i / P.n;
+        double r = R * uniform(rng, 0.5, 1.0);
+        P.V[i].x = r * cos(a);
+        P.V[i].y = r * sin(a);
+    }
+}
+
+void gen_Convex( Polygon &P, unsigned seed )
+{
+    const double R = 1e6;
+    std::mt19937 rng(seed);
+    for (int i=0; i < P.n; i++) {
+        double a = 2 * PI * (i + uniform(rng, 0, 0.5)) / P.n;
+        P.V[i].x = R * cos(a);
+        P.V[i].y = R * sin(a);
+    }
+}
+
+// The strip's inner edge is at radius r0 + p*theta/2pi, its outer edge
+// p/2 further out, each jittered by up to p/16: a strip is 3p/8 clear of
+// the next turn.  Capping the turns at n/32 keeps 16 vertices to a turn
+// for small n, and at n^(1/3) keeps the chords' sag far below 3p/8.
+void gen_Spiral( Polygon &P, unsigned seed )
+{
+    const double p = 1000;         // pitch: spacing of the turns
+    std::mt19937 rng(seed);
+    int    m = P.n / 2;            // outer edge vertices
+    int    k = P.n - m;            // inner edge vertices
+    double turns = cbrt((double)P.n);
+    if (turns > P.n / 32.0)
+        turns = P.n / 32.0;
+    double span = 2 * PI * turns;
+
+    for (int j=0; j < m; j++) {    // out along the outer edge
+        double t = span * j / (m - 1);
+        double r = p + p * t / (2 * PI) + p / 2 + uniform(rng, -p/16, p/16);
+        P.V[j].x = r * cos(t);
+        P.V[j].y = r * sin(t);
+    }
+    for (int j=0; j < k; j++) {    // and back along the inner one
+        double t = span * (k - 1 - j) / (k - 1);
+        double r = p + p * t / (2 * PI) + uniform(rng, -p/16, p/16);
+        P.V[m+j].x = r * cos(t);
+        P.V[m+j].y = r * sin(t);
+    }
+}
+
+// Tooth t is (0,2t) (L,2t) (L,2t+1) (0,2t+1); the back runs down x = -1,
+// with any vertices left over spread along it.
+void gen_Comb( Polygon &P, unsigned seed )
+{
+    const double L = 1e6;
+    std::mt19937 rng(seed);
+    int k = (P.n - 2) / 4;         // teeth
+    int extra = P.n - 4 * k - 2;
+    int i = 0;
+
+    for (int t=0; t < k; t++) {
+        double len = L * uniform(rng, 0.25, 1.0);
+        P.V[i].x = 0;    P.V[i++].y = 2 * t;
+        P.V[i].x = len;  P.V[i++].y = 2 * t;
+        P.V[i].x = len;  P.V[i++].y = 2 * t + 1;
+        P.V[i].x = 0;    P.V[i++].y = 2 * t + 1;
+    }
+    P.V[i].x = -1;  P.V[i++].y = 2 * k - 1;
+    for (int j=0; j < extra; j++) {
+        P.V[i].x = -1;
+        P.V[i++].y = (2.0 * k - 1) * (extra - j) / (extra + 1);
+    }
+    P.V[i].x = -1;  P.V[i++].y = 0;
+}
+
+// Corners (0,0) (L,0) (L,L), the sides' vertices at least 2 apart; a
+// vertex bumped off its side moves 1 (or (1,1) on the diagonal) outward.
+// The coordinates stay below 2^26, so isLeft() is exact on them.
+void gen_Collinear( Polygon &P, unsigned seed )
+{
+    std::mt19937 rng(seed);
+    int m1 = P.n / 3;
+    int m2 = P.n / 3;
+    int m3 = P.n - m1 - m2;
+    long long L = 2LL * m3;        // m3 is the longest side
+    int i = 0;
+
+    for (int j=0; j < m1; j++) {   // bottom, (0,0) to (L,0)
+        P.V[i].x = (double)(j * L / m1);
+        P.V[i++].y = (j > 0 && (rng() & 1)) ? -1 : 0;
+    }
+    for (int j=0; j < m2; j++) {   // right, (L,0) to (L,L)
+        P.V[i].x = (double)((j > 0 && (rng() & 1)) ? L + 1 : L);
+        P.V[i++].y = (double)(j * L / m2);
+    }
+    for (int j=0; j < m3; j++) {   // diagonal, (L,L) back to (0,0)
+        double d = (double)(L - j * L / m3);
+        bool   bump = j > 0 && (rng() & 1);
+        P.V[i].x = bump ? d - 1 : d;
+        P.V[i++].y = bump ? d + 1 : d;
+    }
+}
+
+void gen_Monotone( Polygon &P, unsigned seed )
+{
+    std::mt19937 rng(seed);
+    int m = P.n / 2;               // top chain, left to right
+    int k = P.n - m;               // bottom chain, right to left
+    for (int j=0; j < m; j++) {
+        P.V[j].x = j;
+        P.V[j].y = uniform(rng, 1, 1000);
+    }
+    for (int j=0; j < k; j++) {
+        P.V[m+j].x = (double)(m - 1) * (k - 1 - j) / (k - 1);
+        P.V[m+j].y = -uniform(rng, 1, 1000);
+    }
+}
+
+// T = (R,0) is vertex 0 and vertex m+1.  The outer loop goes round
+// counterclockwise at radius 0.9R..R from angle pi/8 to 2pi - pi/8, so
+// it stays left of x = R cos(pi/8); the inner one goes round clockwise
+// at radius 0.4R..0.5R, inside it.
+void gen_LastTouch( Polygon &P, unsigned seed )
+{
+    const double R = 1e6;
+    const double a = PI / 8;
+    std::mt19937 rng(seed);
+    int m = 2 * P.n / 3;           // outer loop vertices, but for T
+    int k = P.n - m - 2;           // inner loop vertices, but for T
+    int i = 0;
+
+    P.V[i].x = R;  P.V[i++].y = 0;
+    for (int j=0; j < m; j++) {
+        double t = a + (2 * PI - 2 * a) * j / (m - 1);
+        double r = R * uniform(rng, 0.9, 1.0);
+        P.V[i].x = r * cos(t);
+        P.V[i++].y = r * sin(t);
+    }
+    P.V[i].x = R;  P.V[i++].y = 0;
+    for (int j=0; j < k; j++) {
+        double t = -a - (2 * PI - 2 * a) * j / (k - 1);
+        double r = R * uniform(rng, 0.4, 0.5);
+        P.V[i].x = r * cos(t);
+        P.V[i++].y = r * sin(t);
+    }
+}
+
+const Generator Generators[] = {
+    { "Star",       gen_Star,       true  },
+    { "Convex",     gen_Convex,     true  },
+    { "Spiral",     gen_Spiral,     true  },
+    { "Comb",       gen_Comb,       true  },
+    { "Collinear",  gen_Collinear,  true  },
+    { "Monotone",   gen_Monotone,   true  },
+    { "LastTouch",  gen_LastTouch,  false },
+};
+
+const int NGENERATORS = sizeof(Generators) / sizeof(Generators[0]);
@@ -0,0 +1,50 @@
+// generators.h - Seeded synthetic polygons for the benchmarks and tests
+// Each generator fills in all P.n vertices of a polygon (P.n >= 10) from
+// a std::mt19937 seeded with 'seed', so the same seed and size always
+// give the same polygon, on any machine.  Whether it comes out simple is
+// known by construction, and is in the Generators[] table.
+
+#ifndef GENERATORS_H
+#define GENERATORS_H
+
+#include "simple_polygon.h"
+
+// gen_Star(): random radii about the origin at evenly spaced angles,
+// which is simple for any radii
+void gen_Star( Polygon &P, unsigned seed );
+
+// gen_Convex(): points on a circle at jittered, evenly spread angles
+void gen_Convex( Polygon &P, unsigned seed );
+
+// gen_Spiral(): a strip wound round an Archimedean spiral, about n^(1/3)
+// turns of it, so the sweep line cuts many chains
+void gen_Spiral( Polygon &P, unsigned seed );
+
+// gen_Comb(): a back with about n/4 teeth of random length sticking out
+// in +x, so the sweep line cuts about n/2 chains at once
+void gen_Comb( Polygon &P, unsigned seed );
+
+// gen_Collinear(): a right triangle in integer coordinates whose sides
+// are long runs of exactly collinear vertices, some of them bumped off
+// the line by 1 so the runs are also nearly collinear
+void gen_Collinear( Polygon &P, unsigned seed );
+
+// gen_Monotone(): an x-monotone polygon, a top and a bottom chain of
+// random heights, cheap to make at any size
+void gen_Monotone( Polygon &P, unsigned seed );
+
+// gen_LastTouch(): a ring that goes round an outer loop and an inner one,
+// meeting itself only at its rightmost vertex, so it is NOT simple and
+// the sweep only finds out at the very last event
+void gen_LastTouch( Polygon &P, unsigned seed );
+
+typedef struct {
+    const char* name;
+    void     (*make)( Polygon &P, unsigned seed );
+    bool     simple;       // what simple_Polygon() must return
+} Generator;
+
+extern const Generator Generators[];
+extern const int NGENERATORS;
+
+#endif  /* GENERATORS_H */
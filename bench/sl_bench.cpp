@@ -0,0 +1,157 @@
+// sl_bench.cpp - simple_Polygon() throughput on the synthetic polygons
+// One benchmark per generator, status tree and way of allocating, each
+// at n = 10, 100, ... 10^7 vertices, named <generator>/<status>/<alloc>/n.
+// 'warm' sweeps in a SweepContext kept from one call to the next, as a
+// validation server would, so its pools and event arrays are already
+// grown; 'cold' makes a new context for every call, so every sweep pays
+// for malloc'ing them.  vertices/s is the number to watch, e.g.
+//
+//     sl_bench --benchmark_filter='Comb/.*/warm/100000$'
+//
+// A sweep that gets the wrong answer stops its benchmark with an error.
+// Built with SWEEP_STATS (cmake -DSWEEPLINE_STATS=ON), each benchmark
+// also reports the counts of one more sweep, taken after the timed ones:
+// comparisons, isLeft() calls and tree steps per vertex, and the peak.
+//
+// isLeft/<data> times the predicate alone, on triples of vertices of a
+// Star (typical) or on triples within a unit of collinear (near), which
+// the exact predicates must work out exactly.  The build makes sl_bench
+// with the isLeft() that was configured and sl_bench_exact (or
+// sl_bench_plain) with the other one; their 'predicates' context says
+// which is which, and the same filter run on both gives what
+// EXACT_PREDICATES costs, e.g.
+//
+//     sl_bench_exact --benchmark_filter='/warm/100000$|isLeft'
+
+#include <string>
+#include <random>
+#include <vector>
+#include <benchmark/benchmark.h>
+#include "simple_polygon.h"
+#include "generators.h"
+#include "SweepStats.h"
+#include "EventQueue.h"
+
+static const char* StatusName[STATUS_KINDS] = { "avl", "rb", "btree" };
+
+// the polygon of the last benchmark run: the library runs each benchmark
+// several times over, and a big one takes a while to make
+static Polygon* Last = (Polygon*)0;
+static const Generator* LastGen = (const Generator*)0;
+
+static Polygon& polygon( const Generator* g, int n )
+{
+    if (!Last || LastGen != g || Last->n != n) {
+        delete Last;
+        Last = new Polygon(n);
+        LastGen = g;
+        g->make(*Last, 12345);
+    }
+    return *Last;
+}
+
+static void BM_simple_Polygon( benchmark::State &state, const Generator* g,
+                               StatusKind status, bool warm )
+{
+    int      n = (int)state.range(0);
+    Polygon& P = polygon(g, n);
+    SweepContext C;
+    C.status = status;
+    if (warm)
+        simple_Polygon(P, C);
+
+    for (auto _ : state) {
+        bool r;
+        if (warm)
+            r = simple_Polygon(P, C);
+        else {
+            SweepContext Cn;
+            Cn.status = status;
+            r = simple_Polygon(P, Cn);
+        }
+        benchmark::DoNotOptimize(r);
+        if (r != g->simple) {
+            state.SkipWithError("wrong answer");
+            break;
+        }
+    }
+    state.counters["vertices/s"] = benchmark::Counter((double)n,
+                                   benchmark::Counter::kIsIterationInvariantRate);
+#ifdef SWEEP_STATS
+    SweepStats S;
+    C.stats = &S;
+    simple_Polygon(P, C);
+    C.stats = (SweepStats*)0;
+    state.counters["compares/v"] = (double)S.compares / n;
+    state.counters["isLefts/v"] = (double)S.isLefts / n;
+    state.counters["steps/v"] = (double)(S.insert_steps + S.delete_steps
+                                         + S.parents) / n;
+    state.counters["peak"] = (double)S.peak;
+    state.counters["sort%"] = S.total_ms > 0 ? 100 * S.sort_ms / S.total_ms : 0;
+#endif
+}
+
+static void BM_isLeft( benchmark::State &state, bool near )
+{
+    const int N = 4096;            // triples, in L1 and L2 at most
+    std::vector<Point> T(3 * N);
+    std::mt19937 rng(12345);
+    if (!near) {
+        Polygon P(N);
+        gen_Star(P, 12345);
+        for (int i=0; i < 3 * N; i++)
+            T[i] = P.V[rng() % N];
+    } else {
+        // a, b = a + k d, and c a lattice step off, or on, the line ab
+        for (int i=0; i < N; i++) {
+            double ax = (double)(rng() % 1000000), ay = (double)(rng() % 1000000);
+            double dx = 1 + rng() % 1000, k = (double)(1 << 20);
+            double j = (double)(rng() % (1 << 20));
+            T[3*i].x = ax;
+            T[3*i].y = ay;
+            T[3*i+1].x = ax + k * dx;
+            T[3*i+1].y = ay + k;
+            T[3*i+2].x = ax + j * dx;
+            T[3*i+2].y = ay + j + (double)(rng() % 3) - 1;
+        }
+    }
+
+    for (auto _ : state) {
+        int s = 0;
+        for (int i=0; i < N; i++)
+            s += isLeft(T[3*i], T[3*i+1], T[3*i+2]) > 0;
+        benchmark::DoNotOptimize(s);
+    }
+    state.counters["isLefts/s"] = benchmark::Counter((double)N,
+                                  benchmark::Counter::kIsIterationInvariantRate);
+}
+
+int main( int argc, char** argv )
+{
+#ifdef EXACT_PREDICATES
+    benchmark::AddCustomContext("predicates", "exact");
+#else
+    benchmark::AddCustomContext("predicates", "plain");
+#endif
+    for (int i=0; i < NGENERATORS; i++)
+        for (int k=0; k < STATUS_KINDS; k++)
+            for (int w=1; w >= 0; w--) {
+                std::string name = std::string(Generators[i].name) + "/"
+                                 + StatusName[k] + (w ? "/warm" : "/cold");
+                benchmark::RegisterBenchmark(name.c_str(), BM_simple_Polygon,
+                                             &Generators[i], (StatusKind)k,
+                                             w != 0)
+                    ->RangeMultiplier(10)->Range(10, 10000000)
+                    ->Unit(benchmark::kMicrosecond);
+            }
+    benchmark::RegisterBenchmark("isLeft/typical", BM_isLeft, false);
+    benchmark::RegisterBenchmark("isLeft/near", BM_isLeft, true);
+
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv))
+        return 1;
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    delete Last;
+    return 0;
+}
@@ -0,0 +1,29 @@
+{
+  "targets": [
+    {
+      "target_name": "sweepline",
+      "sources": [
+        "node/addon.cpp",
+        "lib/simple_Polygon.cpp",
+        "lib/all_Crossings.cpp",
+        "lib/simple_Polygons.cpp",
+        "lib/parallel_simple_Polygon.cpp",
+        "lib/fastest_Status.cpp",
+        "lib/ExternalSweep.cpp",
+        "lib/PolygonFile.cpp",
+        "lib/MeetKernel.cpp",
+        "lib/SimpleValidator.cpp",
+        "lib/SweepStats.cpp",
+        "lib/Engines.cpp"
+      ],
+      "include_dirs": [ "lib" ],
+      "cflags_cc!": [ "-fno-exceptions", "-fno-rtti" ],
+      "cflags_cc": [ "-std=c++11", "-O2", "-ffp-contract=off" ],
+      "libraries": [ "-lpthread" ],
+      "xcode_settings": {
+        "GCC_ENABLE_CPP_EXCEPTIONS": "YES",
+        "OTHER_CPLUSPLUSFLAGS": [ "-std=c++11", "-ffp-contract=off" ]
+      }
+    }
+  ]
+}
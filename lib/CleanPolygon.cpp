@@ -0,0 +1,147 @@
+// CleanPolygon.cpp - Merging near-duplicate vertices in linear time
+// The vertices left where they are, the centres, go in an open
+// addressing hash table by the cell, tol wide, each is in.  A centre
+// within tol of a vertex is in one of the 3 x 3 cells round the vertex's
+// own, and there are at most 4 centres to a cell (they are all more
+// than tol apart), so finding the nearest takes a few probes, however
+// the vertices are spread.
+
+#include <math.h>
+#include <limits>
+#include "CleanPolygon.h"
+
+// C_cell(): the cell, h wide, that coordinate v is in, kept far enough
+// inside int64_t that the cells either side of it are too
+static inline int64_t C_cell( double v, double h )
+{
+    static const double LIM = 4.0e18;
+    double c = floor(v / h);
+    if (c > LIM)
+        c = LIM;
+    if (c < -LIM)
+        c = -LIM;
+    return (int64_t)c;
+}
+
+// C_hash(): where cell cx,cy goes in a table of mask+1 slots
+static inline size_t C_hash( int64_t cx, int64_t cy, size_t mask )
+{
+    uint64_t h = (uint64_t)cx * 0x9E3779B97F4A7C15ULL
+               ^ (uint64_t)cy * 0xC2B2AE3D27D4EB4FULL;
+    return (size_t)(h ^ (h >> 29)) & mask;
+}
+
+// C_round(): v to the nearest multiple of grid
+template <class T>
+static inline T C_round( double v, double grid )
+{
+    double r = floor(v / grid + 0.5) * grid;
+    return std::numeric_limits<T>::is_integer ? (T)llround(r) : (T)r;
+}
+
+template <class T>
+static inline bool C_same( const PointT<T> &a, const PointT<T> &b )
+{
+    return a.x == b.x && a.y == b.y;
+}
+
+template <class T>
+CleanPolygonT<T>::CleanPolygonT( const PolygonT<T> &Pn, double tol,
+                                 double grid )
+    : Q(Pn.n), nmerged(0), ndropped(0), ncollapsed(0)
+{
+    int n = Pn.n;
+    std::vector<PointT<T> > W(n);          // the vertices rounded and merged
+    for (int i=0; i < n; i++) {
+        W[i] = Pn.Vertex(i);
+        if (grid > 0) {
+            W[i].x = C_round<T>((double)W[i].x, grid);
+            W[i].y = C_round<T>((double)W[i].y, grid);
+        }
+    }
+
+    // move each vertex onto the nearest centre within tol, or make it one
+    if (tol > 0 && n > 0) {
+        size_t size = 16;
+        while (size < 2 * (size_t)n)
+            size <<= 1;
+        size_t mask = size - 1;
+        std::vector<int> table(size, -1);  // the centres, by vertex
+        std::vector<int64_t> cx(n), cy(n); // the cells of the centres
+        double tol2 = tol * tol;
+
+        for (int i=0; i < n; i++) {
+            double  x = (double)W[i].x, y = (double)W[i].y;
+            int64_t ix = C_cell(x, tol), iy = C_cell(y, tol);
+            int     best = -1;
+            double  bd = tol2;
+            for (int64_t kx = ix-1; kx <= ix+1; kx++)
+                for (int64_t ky = iy-1; ky <= iy+1; ky++)
+                    for (size_t s = C_hash(kx, ky, mask); table[s] >= 0;
+                         s = (s + 1) & mask) {
+                        int c = table[s];
+                        if (cx[c] != kx || cy[c] != ky)
+                            continue;
+                        double ex = (double)W[c].x - x, ey = (double)W[c].y - y;
+                        double d = ex*ex + ey*ey;
+                        if (best < 0 ? d <= bd : d < bd) {
+                            best = c;
+                            bd = d;
+                        }
+                    }
+            if (best >= 0) {
+                if (!C_same(W[i], W[best]))
+                    nmerged++;
+                W[i] = W[best];
+                continue;
+            }
+            cx[i] = ix;
+            cy[i] = iy;
+            size_t s = C_hash(ix, iy, mask);
+            while (table[s] >= 0)
+                s = (s + 1) & mask;
+            table[s] = i;
+        }
+    }
+
+    // drop the zero length edges round each ring, the closing one too
+    int m = 0;
+    src.reserve(n);
+    starts.push_back(0);
+    for (int k=0; k < Pn.nr; k++) {
+        int a = Pn.RingStart(k), b = Pn.RingEnd(k), m0 = m;
+        for (int i=a; i < b; i++) {
+            if (m > m0 && C_same(W[i], Q.V[m-1]))
+                continue;
+            Q.V[m++] = W[i];
+            src.push_back(i);
+        }
+        while (m - m0 > 1 && C_same(Q.V[m-1], Q.V[m0])) {
+            m--;
+            src.pop_back();
+        }
+        if (m - m0 < 3 && m - m0 < b - a) {    // too few left: keep it whole
+            m = m0;
+            src.resize(m0);
+            for (int i=a; i < b; i++) {
+                Q.V[m++] = W[i];
+                src.push_back(i);
+            }
+            ncollapsed++;
+        }
+        starts.push_back(m);
+    }
+    Q.n = m;
+    ndropped = n - m;
+    if (Pn.nr > 1)
+        Q.SetRings(&starts[0], Pn.nr);
+}
+
+// the coordinate types CleanPolygon is built for
+template class CleanPolygonT<double>;
+template class CleanPolygonT<float>;
+#ifdef __SIZEOF_INT128__
+template class CleanPolygonT<int32_t>;
+template class CleanPolygonT<int64_t>;
+#endif  /* __SIZEOF_INT128__ */
+//===================================================================
@@ -0,0 +1,59 @@
+// CleanPolygon.h - A polygon with its near-duplicate vertices merged
+// Data that has been through a few conversions is full of vertices a
+// hair apart: a closing vertex repeated, a vertex written twice, a hole
+// that was meant to touch its shell at a vertex but misses it by the
+// last bit.  simple_Polygon() takes the polygon as it is, and says a
+// zero length edge makes it NOT simple, and two vertices 1e-12 apart do
+// not touch.  A CleanPolygon is a copy of a polygon made first
+//
+//     - rounded to the nearest multiples of 'grid', if grid > 0,
+//     - with each vertex within 'tol' of one already seen moved onto it,
+//       found in a hash of cells tol wide, so it takes linear time,
+//     - and with the zero length edges that leaves dropped, round each
+//       ring,
+//
+// so that vertices that were meant to be the same are, and compare so in
+// the sweep:
+//
+//     CleanPolygon Q(P, 1e-9);
+//     bool simple = simple_Polygon(Q.Poly());
+//     int  v = Q.Source(j);               // P's vertex that j came from
+//
+// A ring left with fewer than 3 vertices is kept whole, merged but with
+// none dropped, and so is NOT simple.  Merging is greedy: a vertex moves
+// onto the nearest of those it is within tol of that were not moved
+// themselves, so a chain of vertices each within tol of the next may
+// end up at more than one point.
+
+#ifndef CLEANPOLYGON_H
+#define CLEANPOLYGON_H
+
+#include <vector>
+#include "simple_polygon.h"
+
+template <class T>
+class CleanPolygonT {
+public:
+    // Pn cleaned, as above; tol and grid are in Pn's coordinates
+    CleanPolygonT(const PolygonT<T> &Pn, double tol, double grid=0);
+
+    PolygonT<T> &  Poly() { return Q; }
+
+    int      Source( int j ) const { return src[j]; }  // Pn's vertex j was
+    int      Merged() const { return nmerged; }        // moved onto another
+    int      Dropped() const { return ndropped; }      // vertices taken out
+    int      Collapsed() const { return ncollapsed; }  // rings kept whole
+
+private:
+    PolygonT<T> Q;                 // the cleaned polygon
+    std::vector<int> starts;       // its ring starts
+    std::vector<int> src;          // src[j], the vertex of Pn j was
+    int      nmerged, ndropped, ncollapsed;
+
+    CleanPolygonT(const CleanPolygonT &);
+    CleanPolygonT & operator=(const CleanPolygonT &);
+};
+
+typedef CleanPolygonT<double> CleanPolygon;
+
+#endif  /* CLEANPOLYGON_H */
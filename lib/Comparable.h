@@ -0,0 +1,54 @@
+//Comparable.h - Class for comparing AVL tree nodes
+// Written by Brad Appleton (1997)
+// http://www.bradapp.com/ftp/src/libs/C++/AvlTrees.html
+
+#ifndef COMPARABLE_H
+#define COMPARABLE_H
+
+#include <ostream>
+
+using namespace std;
+
+// cmp_t is an enumeration type indicating the result of a
+// comparison.
+//     NOTE: I would place this inside the Comparable class but
+//           when I do, g++ complains when I use cmp_t. Even
+//           when I prefix it with Comparable:: or Comparable<KeyType>::
+//           (If you can get this working please let me know)
+//
+enum  cmp_t {
+   MIN_CMP = -1,   // less than
+   EQ_CMP  = 0,    // equal to
+   MAX_CMP = 1     // greater than
+};
+
+// Class "Comparable" is the comparator policy of a tree of keys of type
+// KeyType that have an ordering relation (== and <).  A tree of keys that
+// order some other way is given a policy class of its own, with the same
+// static Compare() member.  Being a template parameter of the tree, and
+// static, the comparison is inlined into the tree's search loops.
+//
+template <class KeyType>
+class Comparable {
+public:
+      // Compare the given key against an item in the tree & return the
+      // result: MIN_CMP if the key is less than the item
+   static cmp_t Compare(const KeyType & item, const KeyType & key) {
+      return (key == item) ? EQ_CMP
+                           : ((key < item) ? MIN_CMP : MAX_CMP);
+   }
+};
+
+// Class "ItemComparable" is the comparator policy for keys that point to
+// items with a Compare(key) member of their own, such as sweep line
+// segments, which order by their geometry
+//
+template <class KeyType>
+class ItemComparable {
+public:
+   static cmp_t Compare(const KeyType & item, const KeyType & key) {
+      return  item->Compare(key);
+   }
+};
+
+#endif  /* COMPARABLE_H */
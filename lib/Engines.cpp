@@ -0,0 +1,427 @@
+// Engines.cpp - simple_Polygon() by brute force, a uniform grid or an
+// R-tree (Engines.h)
+// Each engine finds candidate pairs of edges its own way and hands them
+// to N_meet(), which skips those whose boxes do not overlap and those
+// consecutive round a ring, and tests the rest with E_meet(): the rules
+// the sweep and P_brute() go by, so all of them give the same answers.
+
+#include <math.h>
+#include <algorithm>
+#include "EventQueue.h"
+#include "Engines.h"
+
+#define GRID_COVER  4      // most cells an edge covers, on average
+#define GRID_PAIRS  32     // most pairs in a cell, per edge
+#define RTREE_NODE  8      // children of an R-tree node
+
+// N_edges(): the edges of Pn, in W, each in xy order
+//     Return: false if one has zero length (Pn is NOT simple)
+template <class T>
+static bool N_edges( PolygonT<T> &Pn, EngineWorkT<T> &W )
+{
+    int n = Pn.n;
+    W.L.resize(n);
+    W.R.resize(n);
+    W.B.resize(n);
+    W.next.resize(n);
+    for (int k=0; k < Pn.nr; k++) {
+        int a = Pn.RingStart(k);
+        int b = Pn.RingEnd(k);
+        PointT<T> v0 = Pn.Vertex(a);
+        PointT<T> p = v0;
+        for (int i=a; i < b; i++) {
+            int       j = (i+1 < b) ? i+1 : a;
+            PointT<T> q = (j == a) ? v0 : Pn.Vertex(j);
+            int       r = xyorder(&p, &q);
+            if (r == 0)
+                return false;  // the edges either side of it meet
+            W.next[i] = j;
+            W.L[i] = (r < 0) ? p : q;
+            W.R[i] = (r < 0) ? q : p;
+            EBox &e = W.B[i];
+            e.x0 = (double)W.L[i].x;
+            e.x1 = (double)W.R[i].x;
+            e.y0 = (double)((p.y < q.y) ? p.y : q.y);
+            e.y1 = (double)((p.y < q.y) ? q.y : p.y);
+            p = q;
+        }
+    }
+    return true;
+}
+
+// N_overlap(): if boxes p and q overlap, or touch
+static inline bool N_overlap( const EBox &p, const EBox &q )
+{
+    return p.x0 <= q.x1 && q.x0 <= p.x1 && p.y0 <= q.y1 && q.y0 <= p.y1;
+}
+
+// N_meet(): if edges i and j meet, and are not consecutive
+template <class T>
+static inline bool N_meet( const EngineWorkT<T> &W, int i, int j )
+{
+    if (!N_overlap(W.B[i], W.B[j]))
+        return false;
+    if (W.next[i] == j || W.next[j] == i)
+        return false;
+    return E_meet(W.L[i], W.R[i], W.L[j], W.R[j]);
+}
+//===================================================================
+
+
+// Brute force
+// In x order of their left ends, each edge is tested against the later
+// ones that start before it ends: fewest steps for small polygons, and
+// no worse than n^2 / 2 tests for any.
+
+template <class T>
+int brute_Simple( PolygonT<T> &Pn, EngineWorkT<T> &W )
+{
+    if (!N_edges(Pn, W))
+        return 0;
+    int n = Pn.n;
+    std::vector<int> &id = W.a;
+    id.resize(n);
+    for (int i=0; i < n; i++)
+        id[i] = i;
+    const std::vector<EBox> &B = W.B;
+    std::sort(id.begin(), id.end(),
+              [&B](int i, int j) { return B[i].x0 < B[j].x0; });
+
+    for (int k=0; k < n; k++) {
+        int    i = id[k];
+        double x1 = B[i].x1;
+        for (int m = k+1; m < n && B[id[m]].x0 <= x1; m++)
+            if (N_meet(W, i, id[m]))
+                return 0;
+    }
+    return 1;
+}
+//===================================================================
+
+
+// Uniform grid
+// The polygon's box is cut into about n cells, as near square as its
+// shape allows, and each edge listed in every cell its box covers.  Two
+// edges whose boxes overlap share the cell their overlap's lowest corner
+// is in, and are tested there only.  A polygon whose edges cover too
+// many cells, or crowd into a few, is left to the sweep.
+
+// the cells of a grid, nx by ny, from x0,y0 with sx, sy cells a unit
+typedef struct {
+    double   x0, y0, sx, sy;
+    int      nx, ny;
+} EGrid;
+
+static inline int N_col( const EGrid &G, double x )
+{
+    int c = (int)((x - G.x0) * G.sx);
+    return (c < G.nx) ? c : G.nx - 1;
+}
+
+static inline int N_row( const EGrid &G, double y )
+{
+    int c = (int)((y - G.y0) * G.sy);
+    return (c < G.ny) ? c : G.ny - 1;
+}
+
+template <class T>
+int grid_Simple( PolygonT<T> &Pn, EngineWorkT<T> &W )
+{
+    if (!N_edges(Pn, W))
+        return 0;
+    int n = Pn.n;
+    const std::vector<EBox> &B = W.B;
+    EBox all = B[0];
+    for (int i=1; i < n; i++) {
+        all.x0 = std::min(all.x0, B[i].x0);
+        all.y0 = std::min(all.y0, B[i].y0);
+        all.x1 = std::max(all.x1, B[i].x1);
+        all.y1 = std::max(all.y1, B[i].y1);
+    }
+
+    // about n cells: the (int) casts in N_col() and N_row() round down,
+    // as they must for an edge's cells to be those its box covers, since
+    // the coordinates are all from x0, y0 up
+    EGrid  G;
+    double w = all.x1 - all.x0, h = all.y1 - all.y0;
+    G.x0 = all.x0;
+    G.y0 = all.y0;
+    if (w > 0 && h > 0) {
+        G.nx = (int)ceil(sqrt(n * w / h));
+        G.nx = std::max(1, std::min(G.nx, n));
+        G.ny = std::max(1, std::min((n + G.nx - 1) / G.nx, n));
+    }
+    else {
+        G.nx = (w > 0) ? n : 1;
+        G.ny = (h > 0) ? n : 1;
+    }
+    G.sx = (w > 0) ? G.nx / w : 0;
+    G.sy = (h > 0) ? G.ny / h : 0;
+
+    // count the edges in each cell, and leave it to the sweep if there
+    // would be too many
+    int ncell = G.nx * G.ny;
+    std::vector<int> &start = W.b;
+    start.assign(ncell + 1, 0);
+    int64_t cover = 0;
+    for (int i=0; i < n; i++) {
+        int c0 = N_col(G, B[i].x0), c1 = N_col(G, B[i].x1);
+        int r0 = N_row(G, B[i].y0), r1 = N_row(G, B[i].y1);
+        cover += (int64_t)(c1 - c0 + 1) * (r1 - r0 + 1);
+        if (cover > (int64_t)GRID_COVER * n)
+            return -1;
+        for (int r=r0; r <= r1; r++)
+            for (int c=c0; c <= c1; c++)
+                start[r * G.nx + c + 1]++;
+    }
+    int64_t pairs = 0;
+    for (int k=0; k < ncell; k++) {
+        pairs += (int64_t)start[k+1] * start[k+1];
+        start[k+1] += start[k];
+    }
+    if (pairs > (int64_t)GRID_PAIRS * n)
+        return -1;
+
+    std::vector<int> &cell = W.c;
+    std::vector<int> &at = W.a;        // where the next one goes
+    cell.resize(cover);
+    at.assign(start.begin(), start.end() - 1);
+    for (int i=0; i < n; i++) {
+        int c0 = N_col(G, B[i].x0), c1 = N_col(G, B[i].x1);
+        int r0 = N_row(G, B[i].y0), r1 = N_row(G, B[i].y1);
+        for (int r=r0; r <= r1; r++)
+            for (int c=c0; c <= c1; c++)
+                cell[at[r * G.nx + c]++] = i;
+    }
+
+    for (int r=0; r < G.ny; r++)
+        for (int c=0; c < G.nx; c++) {
+            int k = r * G.nx + c;
+            for (int p = start[k]; p < start[k+1]; p++)
+                for (int q = p+1; q < start[k+1]; q++) {
+                    int i = cell[p], j = cell[q];
+                    if (!N_overlap(B[i], B[j]))
+                        continue;
+                    if (N_col(G, std::max(B[i].x0, B[j].x0)) != c
+                        || N_row(G, std::max(B[i].y0, B[j].y0)) != r)
+                        continue;  // tested in the cell the overlap starts in
+                    if (N_meet(W, i, j))
+                        return 0;
+                }
+        }
+    return 1;
+}
+//===================================================================
+
+
+// R-tree
+// Packed bottom up in sort-tile-recursive order (Leutenegger, Lopez and
+// Edgington, "STR: A Simple and Efficient Algorithm for R-Tree Packing",
+// 1997): the boxes of a level sorted by the x of their centres, cut into
+// about sqrt(n / RTREE_NODE) vertical slices, each sorted by y and packed
+// RTREE_NODE to a node.  Its nodes follow clusters of edges, however
+// unevenly they are spread, where a grid's cells would not.  The leaves
+// are the exception: a ring's edges lie near the ones either side of
+// them, so runs of RTREE_NODE of them round the rings make tighter
+// leaves than sorting would, for nothing.  The tree is then joined with
+// itself, to find the pairs of leaves that overlap.
+
+// N_pack(): one level of the tree over ids[m], from boxes Bx, in STR
+// order or (str false) in the order they are: the new nodes' ids go in up
+template <class T>
+static void N_pack( EngineWorkT<T> &W, std::vector<int> &ids,
+                    const std::vector<EBox> &Bx, std::vector<int> &up,
+                    bool str )
+{
+    int m = (int)ids.size();
+    int nodes = (m + RTREE_NODE - 1) / RTREE_NODE;
+    int slice = (int)ceil(sqrt((double)nodes)) * RTREE_NODE;
+    if (str) {
+        std::sort(ids.begin(), ids.end(), [&Bx](int i, int j) {
+            return Bx[i].x0 + Bx[i].x1 < Bx[j].x0 + Bx[j].x1; });
+        for (int s=0; s < m; s += slice)
+            std::sort(ids.begin() + s, ids.begin() + std::min(s + slice, m),
+                      [&Bx](int i, int j) {
+                return Bx[i].y0 + Bx[i].y1 < Bx[j].y0 + Bx[j].y1; });
+    }
+
+    up.clear();
+    for (int g=0; g < m; g += RTREE_NODE) {
+        int  e = std::min(g + RTREE_NODE, m);
+        EBox b = Bx[ids[g]];
+        for (int k = g+1; k < e; k++) {
+            const EBox &c = Bx[ids[k]];
+            b.x0 = std::min(b.x0, c.x0);
+            b.y0 = std::min(b.y0, c.y0);
+            b.x1 = std::max(b.x1, c.x1);
+            b.y1 = std::max(b.y1, c.y1);
+        }
+        up.push_back((int)W.NB.size());
+        W.NB.push_back(b);
+        W.first.push_back((int)W.kid.size());
+        W.count.push_back(e - g);
+        W.kid.insert(W.kid.end(), ids.begin() + g, ids.begin() + e);
+    }
+}
+
+template <class T>
+int rtree_Simple( PolygonT<T> &Pn, EngineWorkT<T> &W )
+{
+    if (!N_edges(Pn, W))
+        return 0;
+    int n = Pn.n;
+
+    // the leaves over runs of edges round the rings, then each level
+    // over the one below, until one node is left.  A level's boxes are
+    // copied out of NB first, as packing it adds to NB.
+    W.NB.clear();
+    W.first.clear();
+    W.count.clear();
+    W.kid.clear();
+    std::vector<int> &ids = W.a, &up = W.b;
+    ids.resize(n);
+    for (int i=0; i < n; i++)
+        ids[i] = i;
+    N_pack(W, ids, W.B, up, false);
+    W.leaves = (int)W.NB.size();
+    std::vector<EBox> level;
+    while (up.size() > 1) {
+        level.assign(W.NB.begin(), W.NB.end());
+        ids.swap(up);
+        N_pack(W, ids, level, up, true);
+    }
+    int root = up[0];
+
+    // the tree joined with itself: pairs of nodes of one level whose boxes
+    // overlap, from the root's pair with itself down to pairs of leaves
+    std::vector<int> &stack = W.c;     // node pairs, two ints each
+    stack.clear();
+    stack.push_back(root);
+    stack.push_back(root);
+    while (!stack.empty()) {
+        int q = stack.back();
+        stack.pop_back();
+        int p = stack.back();
+        stack.pop_back();
+        const int* pk = &W.kid[W.first[p]];
+        const int* qk = &W.kid[W.first[q]];
+        int np = W.count[p], nq = W.count[q];
+        if (p < W.leaves) {
+            for (int i=0; i < np; i++)
+                for (int j = (p == q) ? i+1 : 0; j < nq; j++)
+                    if (N_meet(W, pk[i], qk[j]))
+                        return 0;
+            continue;
+        }
+        for (int i=0; i < np; i++)
+            for (int j = (p == q) ? i : 0; j < nq; j++)
+                if (pk[i] == qk[j] || N_overlap(W.NB[pk[i]], W.NB[qk[j]])) {
+                    stack.push_back(pk[i]);
+                    stack.push_back(qk[j]);
+                }
+    }
+    return 1;
+}
+//===================================================================
+
+
+// Choosing an engine
+// From one pass over the vertices: how many x-monotone chains the rings
+// make, the polygon's box, and the sizes of its edges' boxes.  Measured
+// on the generators (bench/generators.h), against each other:
+//
+//   - brute force beats the rest below a couple of hundred vertices;
+//   - the sweep is fastest when there are few chains, as in a monotone
+//     or convex polygon, whatever its size, and when the edges' boxes
+//     pile up deep over the polygon's, as round the middle of a star,
+//     since every engine but the sweep tests each pair that overlaps;
+//   - the grid, when the edges are short beside cells of the polygon's
+//     box over n, and spread over enough of them (the edges' lengths
+//     over the cell size say about what share of the cells they cross);
+//   - the R-tree otherwise: long edges, or edges along a few curves
+//     through a big box, which crowd a grid's cells.
+
+#define BRUTE_N       192  // fewer vertices than this: brute force
+#define SWEEP_CHAINS  64   // fewer chains than n / this: the sweep
+#define SWEEP_DEPTH   2.0  // deeper piles of edge boxes: the sweep
+#define GRID_CELLS    4.0  // at most this many cells an edge: the grid...
+#define GRID_SPREAD   0.1  // ...if spread over this share of them
+
+template <class T>
+EngineKind choose_Engine( const PolygonT<T> &Pn )
+{
+    int    n = Pn.n;
+    int    chains = 0;
+    double x0, y0, x1, y1, sw = 0, sh = 0, sa = 0;
+    if (n < 3)
+        return ENGINE_SWEEP;   // simple_Polygon() needs no sweep for it
+    PointT<T> v = Pn.Vertex(0);
+    x0 = x1 = (double)v.x;
+    y0 = y1 = (double)v.y;
+    for (int k=0; k < Pn.nr; k++) {
+        int a = Pn.RingStart(k);
+        int b = Pn.RingEnd(k);
+        PointT<T> v0 = Pn.Vertex(a);
+        PointT<T> p = v0;
+        int dir = 0, first = 0;            // x directions of the edges
+        for (int i=a; i < b; i++) {
+            PointT<T> q = (i+1 < b) ? Pn.Vertex(i+1) : v0;
+            double w = fabs((double)q.x - (double)p.x);
+            double h = fabs((double)q.y - (double)p.y);
+            sw += w;
+            sh += h;
+            sa += w * h;
+            x0 = std::min(x0, (double)q.x);
+            y0 = std::min(y0, (double)q.y);
+            x1 = std::max(x1, (double)q.x);
+            y1 = std::max(y1, (double)q.y);
+            int d = (q.x > p.x) ? 1 : (q.x < p.x) ? -1 : 0;
+            if (d != 0 && d != dir) {
+                if (dir == 0)
+                    first = d;
+                else
+                    chains++;
+                dir = d;
+            }
+            p = q;
+        }
+        if (dir != 0 && dir != first)
+            chains++;                      // the turn back to the first
+    }
+
+    if (chains * SWEEP_CHAINS < n)
+        return ENGINE_SWEEP;
+    if (n < BRUTE_N)
+        return ENGINE_BRUTE;
+    double area = (x1 - x0) * (y1 - y0);
+    if (!(area > 0) || sa > SWEEP_DEPTH * area)
+        return ENGINE_SWEEP;
+    double cell = sqrt(area / n);
+    double mw = sw / n / cell, mh = sh / n / cell;
+    if ((mw + 1) * (mh + 1) <= GRID_CELLS && mw + mh >= GRID_SPREAD)
+        return ENGINE_GRID;
+    return ENGINE_RTREE;
+}
+//===================================================================
+
+
+// the coordinate types the engines are built for
+template int brute_Simple( PolygonT<double> &, EngineWorkT<double> & );
+template int grid_Simple( PolygonT<double> &, EngineWorkT<double> & );
+template int rtree_Simple( PolygonT<double> &, EngineWorkT<double> & );
+template EngineKind choose_Engine( const PolygonT<double> & );
+template int brute_Simple( PolygonT<float> &, EngineWorkT<float> & );
+template int grid_Simple( PolygonT<float> &, EngineWorkT<float> & );
+template int rtree_Simple( PolygonT<float> &, EngineWorkT<float> & );
+template EngineKind choose_Engine( const PolygonT<float> & );
+#ifdef __SIZEOF_INT128__
+template int brute_Simple( PolygonT<int32_t> &, EngineWorkT<int32_t> & );
+template int grid_Simple( PolygonT<int32_t> &, EngineWorkT<int32_t> & );
+template int rtree_Simple( PolygonT<int32_t> &, EngineWorkT<int32_t> & );
+template EngineKind choose_Engine( const PolygonT<int32_t> & );
+template int brute_Simple( PolygonT<int64_t> &, EngineWorkT<int64_t> & );
+template int grid_Simple( PolygonT<int64_t> &, EngineWorkT<int64_t> & );
+template int rtree_Simple( PolygonT<int64_t> &, EngineWorkT<int64_t> & );
+template EngineKind choose_Engine( const PolygonT<int64_t> & );
+#endif  /* __SIZEOF_INT128__ */
+//===================================================================
@@ -0,0 +1,55 @@
+// Engines.h - simple_Polygon() without a sweep, for the polygons that
+// do not need one
+// Sorting all the events and keeping a status tree costs more than the
+// work itself for many small and medium polygons.  Each engine here
+// finds the pairs of edges whose boxes overlap some other way, and
+// tests them with E_meet(), the sweep's own test, skipping the pairs
+// consecutive around a ring, as the sweep does: so each one says a
+// polygon is simple exactly when the sweep does.
+//
+//     ENGINE_BRUTE  the edges in x order of their left ends, each tested
+//                   against the later ones starting before it ends
+//     ENGINE_GRID   the edges bucketed into a uniform grid of about n
+//                   cells, the edges that share a cell tested
+//     ENGINE_RTREE  a packed R-tree of the edges' boxes, bulk loaded in
+//                   sort-tile-recursive order, joined with itself
+//
+// choose_Engine() picks one from the vertex count and the boxes of the
+// polygon and its edges, in one pass over the vertices.
+
+#ifndef ENGINES_H
+#define ENGINES_H
+
+#include <vector>
+#include "simple_polygon.h"
+
+// a box, as the engines keep them
+typedef struct {
+    double   x0, y0, x1, y1;
+} EBox;
+
+// EngineWork: the memory the engines work in, kept in a SweepContext
+template <class T>
+struct EngineWorkT {
+    std::vector<PointT<T> > L, R;  // edge i is L[i] to R[i], in xy order
+    std::vector<EBox> B;           // B[i], the box of edge i
+    std::vector<int> next;         // next[i], the edge after i round its ring
+    std::vector<int> a, b, c;      // scratch: ids, counts, cell lists
+
+    // the R-tree: node k has children kid[first[k]] .. kid[first[k]+
+    // count[k]-1], which are edges if k < leaves, else nodes
+    std::vector<EBox> NB;
+    std::vector<int> first, count, kid;
+    int      leaves;
+};
+
+// the engines: 0 = Pn is NOT simple, 1 = Pn IS simple, -1 = leave it to
+// the sweep (the grid, when its edges would cover too many cells)
+template <class T>
+int brute_Simple( PolygonT<T> &Pn, EngineWorkT<T> &W );
+template <class T>
+int grid_Simple( PolygonT<T> &Pn, EngineWorkT<T> &W );
+template <class T>
+int rtree_Simple( PolygonT<T> &Pn, EngineWorkT<T> &W );
+
+#endif  /* ENGINES_H */
@@ -0,0 +1,427 @@
+// EventQueue.h - The predicates and sorted event queue of the sweeps
+// Shared by simple_Polygon(), which sweeps the chains of a polygon, and
+// all_Crossings(), which sweeps a set of segments.
+
+#ifndef EVENTQUEUE_H
+#define EVENTQUEUE_H
+
+#include <stdint.h>
+#include <string.h>
+#include <math.h>
+#include <float.h>
+#include "simple_polygon.h"
+#include "SweepStats.h"
+
+// Assume that classes are already given for the objects:
+//    PointT<T> with 2D coordinates {T x, y;}
+//    PolygonT<T> with n vertices {int n; Vertex(i);} in rings, Next(i) after i
+//    Tnode is a node element structure for a BBT
+//    BBT is a class for a Balanced Binary Tree
+//        such as an AVL, a 2-3, or a red-black tree
+//===================================================================
+
+enum SEG_SIDE { LEFT, RIGHT };
+
+// xyorder(): determines the xy lexicographical order of two points
+//      returns: (+1) if p1 > p2; (-1) if p1 < p2; and 0 if equal
+template <class T>
+int xyorder( const PointT<T>* p1, const PointT<T>* p2 )
+{
+    // test the x-coord first
+    if (p1->x > p2->x) return 1;
+    if (p1->x < p2->x) return (-1);
+    // and test the y-coord second
+    if (p1->y > p2->y) return 1;
+    if (p1->y < p2->y) return (-1);
+    // when you exclude all other possibilities, what remains is...
+    return 0;  // they are the same point
+}
+
+// isLeft(): tests if point P2 is Left|On|Right of the line P0 to P1.
+//      returns: >0 for left, 0 for on, and <0 for right of the line.
+//      (see the January 2001 Algorithm on Area of Triangles)
+//
+//      Built with EXACT_PREDICATES defined, the sign is always right:
+//      the plain double result is kept when it is further from 0 than its
+//      worst case round-off, and is otherwise worked out again exactly
+//      (J. R. Shewchuk, "Adaptive Precision Floating-Point Arithmetic
+//      and Fast Robust Geometric Predicates", 1997).
+#ifdef EXACT_PREDICATES
+
+// the exact path is rare: keep it out of line, and out of the way, and
+// the filter in line wherever isLeft() is called, as the plain one is
+#ifdef __GNUC__
+#define NOINLINE        __attribute__((noinline))
+#define ALWAYS_INLINE   __attribute__((always_inline))
+#define LIKELY(c)       __builtin_expect(!!(c), 1)
+#else
+#define NOINLINE
+#define ALWAYS_INLINE
+#define LIKELY(c)       (c)
+#endif
+
+// Two_Sum(): a + b = x + y exactly, x being the rounded sum
+static inline void Two_Sum( double a, double b, double &x, double &y )
+{
+    x = a + b;
+    double bv = x - a;
+    double av = x - bv;
+    y = (a - av) + (b - bv);
+}
+
+// Two_Product(): a * b = x + y exactly, x being the rounded product
+static inline void Two_Product( double a, double b, double &x, double &y )
+{
+    x = a * b;
+    y = fma(a, b, -x);
+}
+
+// Grow_Expansion(): add b to the expansion E[ne] (smallest term first,
+// no zero terms), returning its new length
+static inline int Grow_Expansion( double* E, int ne, double b )
+{
+    int    n = 0;
+    double q = b, h;
+    for (int i=0; i < ne; i++) {
+        Two_Sum(q, E[i], q, h);
+        if (h != 0)
+            E[n++] = h;
+    }
+    if (q != 0)
+        E[n++] = q;
+    return n;
+}
+
+// isLeftExact(): isLeft() in exact arithmetic, rounded at the end
+NOINLINE static double
+isLeftExact( Point P0, Point P1, Point P2 )
+{
+    // 0 exactly, without the expansion, where both products have a factor
+    // of 0 (P2 is P0, or the points are on one axis parallel line) or P2
+    // is P1: the shared ends and straight runs of edges of a polygon
+    if (((P1.x == P0.x || P2.y == P0.y) && (P2.x == P0.x || P1.y == P0.y))
+        || (P2.x == P1.x && P2.y == P1.y))
+        return 0;
+
+    double a[2], b[2], c[2], d[2];         // the differences, exactly
+    Two_Sum(P1.x, -P0.x, a[1], a[0]);
+    Two_Sum(P2.y, -P0.y, b[1], b[0]);
+    Two_Sum(P2.x, -P0.x, c[1], c[0]);
+    Two_Sum(P1.y, -P0.y, d[1], d[0]);
+
+    double E[32];
+    int    ne = 0;
+    for (int i=0; i < 2; i++)
+        for (int j=0; j < 2; j++) {
+            double x, y;
+            Two_Product(a[i], b[j], x, y);
+            ne = Grow_Expansion(E, ne, y);
+            ne = Grow_Expansion(E, ne, x);
+            Two_Product(-c[i], d[j], x, y);
+            ne = Grow_Expansion(E, ne, y);
+            ne = Grow_Expansion(E, ne, x);
+        }
+
+    if (ne == 0)
+        return 0;
+
+    // the largest term has the sign of the whole: round-off in adding
+    // up the rest must not flip it
+    double sum = 0;
+    for (int i=0; i < ne; i++)
+        sum += E[i];
+    return (sum != 0 && (sum > 0) == (E[ne-1] > 0)) ? sum : E[ne-1];
+}
+
+inline ALWAYS_INLINE double
+isLeft( Point P0, Point P1, Point P2 )
+{
+    STAT(isLefts, 1);
+    // a bound on the round-off in det (Shewchuk's ccwerrboundA), to be
+    // taken times |l| + |r|.  |l + r| is that where l and r have one sign;
+    // where they have not, det is further from 0 than either, and right.
+    static const double ERRBOUND = (3.0 + 16.0 * DBL_EPSILON / 2)
+                                   * DBL_EPSILON / 2;
+    double l = (P1.x - P0.x)*(P2.y - P0.y);
+    double r = (P2.x - P0.x)*(P1.y - P0.y);
+    double det = l - r;
+    if (LIKELY(fabs(det) > ERRBOUND * fabs(l + r)))
+        return det;
+    return isLeftExact(P0, P1, P2);
+}
+
+#else
+
+inline double
+isLeft( Point P0, Point P1, Point P2 )
+{
+    STAT(isLefts, 1);
+    return (P1.x - P0.x)*(P2.y - P0.y) - (P2.x - P0.x)*(P1.y - P0.y);
+}
+
+#endif  /* EXACT_PREDICATES */
+
+// isLeft() for float points, worked out in double.  The sign is right
+// whenever the differences of the coordinates and their products are
+// exact, which they are if the three points lie on a grid of step 2^k
+// and within 2^(k+25) of each other in x and in y (such as floats of like
+// magnitude, none of them near 0).  Otherwise the differences or the
+// products may round, as in double, and the sign is only right when the
+// points are not near collinear.  Built with EXACT_PREDICATES, it is
+// the double isLeft(), whose sign is always right.
+inline double
+isLeft( PointT<float> P0, PointT<float> P1, PointT<float> P2 )
+{
+#ifdef EXACT_PREDICATES
+    Point Q0 = { P0.x, P0.y }, Q1 = { P1.x, P1.y }, Q2 = { P2.x, P2.y };
+    return isLeft(Q0, Q1, Q2);
+#else
+    STAT(isLefts, 1);
+    double ax = (double)P1.x - P0.x, ay = (double)P1.y - P0.y;
+    double bx = (double)P2.x - P0.x, by = (double)P2.y - P0.y;
+    return ax*by - bx*ay;
+#endif
+}
+
+// isLeft() for fixed point, exact in 128 bit integers.  Only the sign
+// is handed back (as -1, 0 or +1): no caller needs more from it.
+#ifdef __SIZEOF_INT128__
+inline double
+isLeft( PointT<int32_t> P0, PointT<int32_t> P1, PointT<int32_t> P2 )
+{
+    STAT(isLefts, 1);
+    int64_t ax = (int64_t)P1.x - P0.x, ay = (int64_t)P1.y - P0.y;
+    int64_t bx = (int64_t)P2.x - P0.x, by = (int64_t)P2.y - P0.y;
+    __int128 det = (__int128)ax*by - (__int128)bx*ay;
+    return (det > 0) - (det < 0);
+}
+
+inline double
+isLeft( PointT<int64_t> P0, PointT<int64_t> P1, PointT<int64_t> P2 )
+{
+    STAT(isLefts, 1);
+    __int128 ax = (__int128)P1.x - P0.x, ay = (__int128)P1.y - P0.y;
+    __int128 bx = (__int128)P2.x - P0.x, by = (__int128)P2.y - P0.y;
+    __int128 det = ax*by - bx*ay;
+    return (det > 0) - (det < 0);
+}
+#endif  /* __SIZEOF_INT128__ */
+
+// E_meet(): test if closed segments lP1-rP1 and lP2-rP2 meet, each given
+// left point first in xy order: 0=none, 1=intersect
+template <class T>
+static inline bool E_meet( const PointT<T> &lP1, const PointT<T> &rP1,
+                           const PointT<T> &lP2, const PointT<T> &rP2 )
+{
+    double lsign, rsign;
+    lsign = isLeft(lP1, rP1, lP2);             // s2 left point sign
+    rsign = isLeft(lP1, rP1, rP2);             // s2 right point sign
+    if ((lsign > 0 && rsign > 0) || (lsign < 0 && rsign < 0))
+        return false;      // s2 endpoints on same side of s1 => no intersect
+    bool collinear = (lsign == 0 && rsign == 0);
+    lsign = isLeft(lP2, rP2, lP1);             // s1 left point sign
+    rsign = isLeft(lP2, rP2, rP1);             // s1 right point sign
+    if ((lsign > 0 && rsign > 0) || (lsign < 0 && rsign < 0))
+        return false;      // s1 endpoints on same side of s2 => no intersect
+    if (collinear)         // on one line: they must overlap in xy order
+        return xyorder(&lP1, &rP2) <= 0 && xyorder(&lP2, &rP1) <= 0;
+    // the segments s1 and s2 straddle each other
+    return true;           // => an intersect exists
+}
+//===================================================================
+
+// EventQueue Class
+
+// Event element data struct (Event is the double one).
+// Events are sorted and handed out by value, so a sort pass touches
+// only the events themselves, not the polygon's vertices.
+template <class T>
+struct EventT {
+    PointT<T> P;           // event vertex
+    int      edge;         // polygon edge i is V[i] to V[i+1]
+    enum SEG_SIDE type;    // event type: LEFT or RIGHT vertex
+};
+
+// E_less(): xy order of events, with LEFT before RIGHT at the same point
+template <class T>
+static inline bool E_less( const EventT<T>& e1, const EventT<T>& e2 )
+{
+    int r = xyorder( &e1.P, &e2.P );
+    return (r == 0) ? (e1.type == LEFT && e2.type == RIGHT) : (r < 0);
+}
+
+// xykey(): map a coordinate to an unsigned key in the same order
+static inline uint64_t xykey( double d )
+{
+    uint64_t u;
+    d += 0.0;                          // -0.0 becomes 0.0, as they are equal
+    memcpy( &u, &d, sizeof(u) );
+    return (u >> 63) ? ~u : (u | ((uint64_t)1 << 63));
+}
+
+static inline uint64_t xykey( float d )
+{
+    uint32_t u;
+    d += 0.0f;
+    memcpy( &u, &d, sizeof(u) );
+    return (u >> 31) ? (uint32_t)~u : (u | ((uint32_t)1 << 31));
+}
+
+static inline uint64_t xykey( int32_t d )
+{
+    return (uint32_t)d ^ ((uint32_t)1 << 31);
+}
+
+static inline uint64_t xykey( int64_t d )
+{
+    return (uint64_t)d ^ ((uint64_t)1 << 63);
+}
+
+// E_isort(): insertion sort E[ne] into E_less order (for short runs)
+template <class T>
+static inline void E_isort( EventT<T>* E, int ne )
+{
+    for (int i=1; i < ne; i++) {
+        EventT<T> e = E[i];
+        int   j = i;
+        for ( ; j > 0 && E_less( e, E[j-1] ); j--)
+            E[j] = E[j-1];
+        E[j] = e;
+    }
+}
+
+// E_msort(): merge sort E[ne] into E_less order, using W[ne] as scratch.
+// Polygon vertices come in long runs already in x order, and merging
+// two runs that are already in order is a copy.
+template <class T>
+static void E_msort( EventT<T>* E, EventT<T>* W, int ne )
+{
+    const int RUN = 16;
+    for (int i=0; i < ne; i += RUN)
+        E_isort( E + i, std::min(RUN, ne - i) );
+
+    EventT<T>* src = E;
+    EventT<T>* dst = W;
+    for (int w=RUN; w < ne; w *= 2) {
+        for (int lo=0; lo < ne; lo += 2*w) {
+            int mid = std::min(lo + w, ne);
+            int hi  = std::min(lo + 2*w, ne);
+            int i = lo, j = mid, k = lo;
+            if (mid < hi && E_less( src[mid], src[mid-1] )) {
+                while (i < mid && j < hi)
+                    dst[k++] = E_less( src[j], src[i] ) ? src[j++] : src[i++];
+            }
+            memcpy( dst + k, src + i, (mid - i) * sizeof(EventT<T>) );
+            k += mid - i;
+            memcpy( dst + k, src + j, (hi - j) * sizeof(EventT<T>) );
+        }
+        EventT<T>* t = src; src = dst; dst = t;
+    }
+    if (src != E)
+        memcpy( E, src, ne * sizeof(EventT<T>) );
+}
+
+// E_sort(): sort E[ne] into E_less order, using W[ne] as scratch space.
+// Large queues get an LSD radix sort on the x keys, 11 bits at a time,
+// skipping the digits all events share; then each run of events with the
+// same x is put in y order: by insertion if short, else by merging, as
+// rectilinear and raster data have runs of thousands.
+#define E_SORT_RADIX_MIN 4096  // below this, merge sort is faster
+
+template <class T>
+static void E_sort( EventT<T>* E, EventT<T>* W, int ne )
+{
+    if (ne < E_SORT_RADIX_MIN) {
+        E_msort( E, W, ne );
+        return;
+    }
+
+    static const int BITS = 11;
+    static const int NDIG = (64 + BITS - 1) / BITS;
+    static const int NBKT = 1 << BITS;
+    uint32_t   count[NDIG][NBKT];
+
+    // one pass counts all the digits of the keys
+    memset( count, 0, sizeof(count) );
+    for (int i=0; i < ne; i++) {
+        uint64_t k = xykey( E[i].P.x );
+        for (int d=0; d < NDIG; d++)
+            count[d][(k >> (BITS*d)) & (NBKT-1)]++;
+    }
+
+    EventT<T>* src = E;
+    EventT<T>* dst = W;
+    uint64_t k0 = xykey( E[0].P.x );
+    for (int d=0; d < NDIG; d++) {
+        int shift = BITS * d;
+        uint32_t* c = count[d];
+        if (c[(k0 >> shift) & (NBKT-1)] == (uint32_t)ne)
+            continue;                  // all the same: nothing to do
+
+        uint32_t sum = 0;
+        for (int b=0; b < NBKT; b++) {
+            uint32_t t = c[b];
+            c[b] = sum;
+            sum += t;
+        }
+        for (int i=0; i < ne; i++) {
+            uint64_t k = xykey( src[i].P.x );
+            dst[c[(k >> shift) & (NBKT-1)]++] = src[i];
+        }
+        EventT<T>* t = src; src = dst; dst = t;
+    }
+    if (src != E)
+        memcpy( E, src, ne * sizeof(EventT<T>) );
+
+    for (int i=0, j; i < ne; i = j) {
+        for (j = i+1; j < ne && E[j].P.x == E[i].P.x; j++)
+            ;
+        if (j - i > 16)
+            E_msort( E + i, W + i, j - i );
+        else if (j - i > 1)
+            E_isort( E + i, j - i );
+    }
+}
+
+// the EventQueue is a presorted array (no insertions needed)
+template <class T>
+class EventQueueT {
+    int      ne;               // total number of events in array
+    int      ix;               // index of next event on queue
+    EventT<T>* Eq;             // sorted array of all events (in a SweepContext)
+public:
+    // the ne events already filled in at C.Edata
+    EventQueueT(SweepContextT<T> &C, int ne);
+
+    EventT<T>* next();                  // next event on queue
+    EventT<T>* peek();                  // next event, left on queue
+};
+
+typedef EventQueueT<double> EventQueue;
+
+// EventQueue Routines
+template <class T>
+EventQueueT<T>::EventQueueT( SweepContextT<T> &C, int n )
+{
+    ix = 0;
+    ne = n;
+    Eq = C.Edata;
+    E_sort( Eq, C.Etmp, ne );
+}
+
+template <class T>
+EventT<T>* EventQueueT<T>::next()
+{
+    if (ix >= ne)
+        return (EventT<T>*)0;
+    else
+        return &Eq[ix++];
+}
+
+template <class T>
+EventT<T>* EventQueueT<T>::peek()
+{
+    return (ix < ne) ? &Eq[ix] : (EventT<T>*)0;
+}
+
+#endif  /* EVENTQUEUE_H */
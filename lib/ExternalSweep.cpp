@@ -0,0 +1,444 @@
+// ExternalSweep.cpp - Check a polygon too big for memory
+// The edges are swept one at a time, as in Shamos and Hoey's sweep,
+// rather than in chains: stepping along a chain needs the polygon's
+// vertices at hand, and these are on disk.  Only the left ends of the
+// edges go through the sort.  An edge's right end is kept in memory from
+// when the edge goes into the sweep line to when it comes out, in a heap
+// of the edges in the sweep line, so the sweep's memory goes with how
+// many edges it cuts at once, not with n.
+// Sorted runs of left end events are spilled to temporary files, and
+// merged FANIN at a time until few enough are left to merge in one pass
+// straight into the sweep.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <stdexcept>
+#include <algorithm>
+#include <queue>
+#include "Avl.h"
+#include "Status.h"
+#include "EventQueue.h"
+
+// the left end event of edge 'edge', lP to rP; 'next' is the edge after
+// it around its ring
+template <class T>
+struct XMeventT {
+    PointT<T> lP;
+    PointT<T> rP;
+    int64_t  edge;
+    int64_t  next;
+};
+
+// M_less(): the sweep order of left end events
+template <class T>
+static inline bool M_less( const XMeventT<T>& e1, const XMeventT<T>& e2 )
+{
+    int r = xyorder(&e1.lP, &e2.lP);
+    return r < 0 || (r == 0 && e1.edge < e2.edge);
+}
+
+// External SweepLine segment data
+template <class T>
+class XMsegT {
+public:
+    int64_t  edge;         // edge number, in the order the edges were added
+    int64_t  next;         // the edge after it around its ring
+    PointT<T> lP;          // leftmost vertex point
+    PointT<T> rP;          // rightmost vertex point
+    XMsegT*  above;        // edge above this one
+    XMsegT*  below;        // edge below this one
+    void*    node;         // the status tree's handle on it
+    bool     gone;         // being deleted: follow 'toward' to its node
+    cmp_t    toward;       // the side of this node the deleted one is on
+
+    XMsegT() : gone(false) {}
+
+    // return true if P lies on this edge
+    bool contains( const PointT<T>* P ) const
+    {
+        return isLeft(lP, rP, *P) == 0
+            && xyorder(&lP, P) <= 0 && xyorder(P, &rP) <= 0;
+    }
+
+    // 'key' is below this edge if its left point is below it, or is on
+    // it and key runs below it from there (as for SLsegT)
+    cmp_t Compare(XMsegT* key) const
+    {
+        if (key == this)
+            return EQ_CMP;
+        if (key->gone)
+            return toward;
+
+        double d = isLeft(lP, rP, key->lP);
+        if (d == 0)
+            d = isLeft(lP, rP, key->rP);
+        if (d == 0)                          // collinear: order by edge
+            d = (double)(key->edge - edge);
+        return (d < 0) ? MIN_CMP : MAX_CMP;
+    }
+};
+
+// the order of the right end heap: s1 comes out after s2
+template <class T>
+struct M_later {
+    bool operator()( const XMsegT<T>* s1, const XMsegT<T>* s2 ) const
+    {
+        int r = xyorder(&s1->rP, &s2->rP);
+        return r > 0 || (r == 0 && s1->edge > s2->edge);
+    }
+};
+
+// a sorted run of events, read back from its file through a buffer, or
+// already in memory
+template <class T>
+class RunReader {
+    FILE*    f;            // the run's file, or 0 if it is in memory
+    XMeventT<T>* buf;
+    size_t   cap;          // events buf can hold
+    size_t   n;            // events in buf
+    size_t   i;            // next one
+public:
+    RunReader(FILE* file, XMeventT<T>* b, size_t c)
+        : f(file), buf(b), cap(c), n(0), i(0) { rewind(f); }
+    RunReader(XMeventT<T>* E, size_t ne)
+        : f((FILE*)0), buf(E), cap(ne), n(ne), i(0) {}
+
+    // the next event, or 0 at the end of the run
+    const XMeventT<T>* peek()
+    {
+        if (i == n) {
+            if (!f)
+                return (const XMeventT<T>*)0;
+            n = fread(buf, sizeof(XMeventT<T>), cap, f);
+            i = 0;
+            if (n == 0) {
+                if (ferror(f))
+                    throw std::runtime_error("ExternalSweep: cannot read a temporary file");
+                return (const XMeventT<T>*)0;
+            }
+        }
+        return &buf[i];
+    }
+
+    void     pop() { i++; }
+};
+
+// the k-way merge of several runs: a heap of the runs by their next event
+template <class T>
+class RunMerge {
+    std::vector<RunReader<T>*> H;
+
+    static bool later( RunReader<T>* a, RunReader<T>* b )
+    {
+        return M_less(*b->peek(), *a->peek());
+    }
+public:
+    ~RunMerge() { for (size_t i=0; i < H.size(); i++) delete H[i]; }
+
+    void     add( RunReader<T>* r )
+    {
+        if (!r->peek()) {
+            delete r;
+            return;
+        }
+        H.push_back(r);
+        std::push_heap(H.begin(), H.end(), later);
+    }
+
+    // the next event of all the runs, or 0 when they are all done
+    const XMeventT<T>* peek()
+    {
+        return H.empty() ? (const XMeventT<T>*)0 : H[0]->peek();
+    }
+
+    void     pop()
+    {
+        std::pop_heap(H.begin(), H.end(), later);
+        RunReader<T>* r = H.back();
+        r->pop();
+        if (r->peek())
+            std::push_heap(H.begin(), H.end(), later);
+        else {
+            H.pop_back();
+            delete r;
+        }
+    }
+};
+//===================================================================
+
+
+// ExternalSweep Routines
+
+enum { FANIN = 64 };       // most runs merged at once, and files open
+
+template <class T>
+ExternalSweepT<T>::ExternalSweepT( size_t bytes, const char* tmpdir )
+    : status(STATUS_AVL), nrun(0), Dir(tmpdir ? tmpdir : ""), budget(bytes),
+      ne(0), ring(0), open(false), degenerate(false)
+{
+    // half the budget for the run being filled, half for reading back
+    room = budget / 2 / sizeof(XMeventT<T>);
+    if (room < 1024)
+        room = 1024;
+    Run = new XMeventT<T>[room];
+}
+
+template <class T>
+ExternalSweepT<T>::~ExternalSweepT()
+{
+    for (size_t i=0; i < Files.size(); i++)
+        fclose(Files[i]);
+    delete[] Run;
+}
+
+// a new temporary file, deleted once it is closed
+template <class T>
+FILE* ExternalSweepT<T>::tmp()
+{
+    FILE* f;
+    if (Dir.empty())
+        f = tmpfile();
+    else {
+        std::string path = Dir + "/slXXXXXX";
+        int fd = mkstemp(&path[0]);
+        f = (FILE*)0;
+        if (fd >= 0) {
+            unlink(path.c_str());
+            f = fdopen(fd, "w+b");
+            if (!f)
+                close(fd);
+        }
+    }
+    if (!f)
+        throw std::runtime_error("ExternalSweep: cannot make a temporary file");
+    return f;
+}
+
+// sort the run in memory, and write it to a file of its own
+template <class T>
+void ExternalSweepT<T>::spill()
+{
+    std::sort(Run, Run + nrun, M_less<T>);
+    FILE* f = tmp();
+    Files.push_back(f);
+    if (fwrite(Run, sizeof(XMeventT<T>), nrun, f) != nrun || fflush(f) != 0)
+        throw std::runtime_error("ExternalSweep: cannot write a temporary file");
+    nrun = 0;
+}
+
+template <class T>
+void ExternalSweepT<T>::edge( const PointT<T> &a, const PointT<T> &b,
+                              int64_t next )
+{
+    int r = xyorder(&a, &b);
+    if (r == 0)
+        degenerate = true; // the edges either side of it meet
+    if (degenerate) {      // the answer is known: keep nothing more
+        ne++;
+        return;
+    }
+    if (nrun == room)
+        spill();
+    XMeventT<T>& e = Run[nrun++];
+    e.lP = (r < 0) ? a : b;
+    e.rP = (r < 0) ? b : a;
+    e.edge = ne++;
+    e.next = next;
+}
+
+template <class T>
+void ExternalSweepT<T>::Add( T x, T y )
+{
+    PointT<T> p;
+    p.x = x;
+    p.y = y;
+    if (!open) {
+        first = p;
+        ring = ne;
+        open = true;
+    }
+    else
+        edge(last, p, ne + 1);
+    last = p;
+}
+
+template <class T>
+void ExternalSweepT<T>::EndRing()
+{
+    if (!open)
+        return;
+    edge(last, first, ring);       // the closing edge, before the first
+    open = false;
+}
+
+// M_intersect(): test intersect of 2 edges: 0=none, 1=intersect
+template <class T>
+static bool M_intersect( XMsegT<T>* s1, XMsegT<T>* s2 )
+{
+    if (s1 == (XMsegT<T>*)0 || s2 == (XMsegT<T>*)0)
+        return false;      // no intersect if either edge doesn't exist
+    if (s1->next == s2->edge || s2->next == s1->edge)
+        return false;      // no non-simple intersect since consecutive
+    return E_meet(s1->lP, s1->rP, s2->lP, s2->rP);
+}
+
+// M_intersectAny(): test edge s against the edges next to it, at its end
+// point P, looking past those that pass through P (as
+// SweepLineT::intersectAny() does)
+template <class T>
+static bool M_intersectAny( XMsegT<T>* s, const PointT<T>* P )
+{
+    XMsegT<T>* t;
+    for (t = s->above; ; t = t->above) {
+        if (M_intersect(s, t))
+            return true;
+        if (t == (XMsegT<T>*)0 || !t->contains(P))
+            break;
+    }
+    for (t = s->below; ; t = t->below) {
+        if (M_intersect(s, t))
+            return true;
+        if (t == (XMsegT<T>*)0 || !t->contains(P))
+            break;
+    }
+    return false;
+}
+
+// M_sweep(): sweep the left end events from M, with the edges in a
+// Status tree
+//     Return: FALSE(0) = the rings are NOT simple
+//             TRUE(1)  = the rings ARE simple
+template <class T, class Status>
+static bool M_sweep( RunMerge<T> &M )
+{
+    typedef XMsegT<T> XMseg;
+
+    Pool     nodes((size_t)StatusAvl<XMseg>::NODE_SIZE
+                   > (size_t)StatusRB<XMseg>::NODE_SIZE
+                   ? (size_t)StatusAvl<XMseg>::NODE_SIZE
+                   : (size_t)StatusRB<XMseg>::NODE_SIZE);
+    Pool     blocks(StatusBtree<XMseg>::NODE_SIZE, 8);
+    Pool     segs(sizeof(XMseg));
+    ArenaScope A(nodes);
+    Status   Tree(nodes, blocks);
+    std::priority_queue<XMseg*, std::vector<XMseg*>, M_later<T> > Rq;
+
+    for (;;) {
+        const XMeventT<T>* e = M.peek();
+        if (!e && Rq.empty())
+            return true;
+
+        // right ends go after any left ends at the same point
+        if (!Rq.empty() && (!e || xyorder(&Rq.top()->rP, &e->lP) < 0)) {
+            XMseg* s = Rq.top();
+            Rq.pop();
+            if (M_intersectAny(s, &s->rP) || M_intersect(s->above, s->below))
+                return false;
+            Tree.Remove(s);
+            if (s->above != (XMseg*)0)
+                s->above->below = s->below;
+            if (s->below != (XMseg*)0)
+                s->below->above = s->above;
+            s->~XMseg();
+            segs.Free(s);
+            continue;
+        }
+
+        XMseg* s = new (segs.Alloc(sizeof(XMseg))) XMseg;
+        s->edge = e->edge;
+        s->next = e->next;
+        s->lP = e->lP;
+        s->rP = e->rP;
+        M.pop();
+        Tree.Insert(s, s->below, s->above);
+        if (s->above != (XMseg*)0)
+            s->above->below = s;
+        if (s->below != (XMseg*)0)
+            s->below->above = s;
+        if (M_intersectAny(s, &s->lP))
+            return false;
+        Rq.push(s);
+    }
+}
+
+template <class T>
+bool ExternalSweepT<T>::Simple()
+{
+    EndRing();
+    bool simple = !degenerate;
+
+    if (simple) {
+        // merge runs FANIN at a time into longer ones, until the rest can
+        // be merged straight into the sweep
+        if (!Files.empty() && nrun > 0)
+            spill();
+        size_t nbuf = (Files.size() < (size_t)FANIN) ? Files.size() : (size_t)FANIN;
+        size_t cap = nbuf ? budget / 2 / nbuf / sizeof(XMeventT<T>) : 0;
+        if (nbuf && cap < 1024)
+            cap = 1024;    // each run's read buffer
+        std::vector<XMeventT<T> > Buf(cap * nbuf);
+        while (Files.size() > (size_t)FANIN) {
+            FILE* out = tmp();
+            Files.push_back(out);
+            {
+                RunMerge<T> M;
+                for (size_t i=0; i < (size_t)FANIN; i++)
+                    M.add(new RunReader<T>(Files[i], &Buf[i * cap], cap));
+                size_t nout = 0;   // Run is free now: buffer the output
+                for (const XMeventT<T>* e; (e = M.peek()) != 0; M.pop()) {
+                    Run[nout++] = *e;
+                    if (nout == room) {
+                        if (fwrite(Run, sizeof(XMeventT<T>), nout, out) != nout)
+                            throw std::runtime_error("ExternalSweep: cannot write a temporary file");
+                        nout = 0;
+                    }
+                }
+                if (fwrite(Run, sizeof(XMeventT<T>), nout, out) != nout
+                    || fflush(out) != 0)
+                    throw std::runtime_error("ExternalSweep: cannot write a temporary file");
+            }
+            for (size_t i=0; i < (size_t)FANIN; i++)
+                fclose(Files[i]);
+            Files.erase(Files.begin(), Files.begin() + FANIN);
+        }
+
+        RunMerge<T> M;
+        if (Files.empty()) {       // it all fitted in memory
+            std::sort(Run, Run + nrun, M_less<T>);
+            M.add(new RunReader<T>(Run, nrun));
+        }
+        for (size_t i=0; i < Files.size(); i++)
+            M.add(new RunReader<T>(Files[i], &Buf[i * cap], cap));
+
+        switch (status) {
+        case STATUS_RB:
+            simple = M_sweep<T, StatusRB<XMsegT<T> > >(M);
+            break;
+        case STATUS_BTREE:
+            simple = M_sweep<T, StatusBtree<XMsegT<T> > >(M);
+            break;
+        default:
+            simple = M_sweep<T, StatusAvl<XMsegT<T> > >(M);
+            break;
+        }
+    }
+
+    // start again, empty
+    for (size_t i=0; i < Files.size(); i++)
+        fclose(Files[i]);
+    Files.clear();
+    nrun = 0;
+    ne = 0;
+    degenerate = false;
+    return simple;
+}
+
+// the coordinate types ExternalSweep is built for
+template class ExternalSweepT<double>;
+template class ExternalSweepT<float>;
+#ifdef __SIZEOF_INT128__
+template class ExternalSweepT<int32_t>;
+template class ExternalSweepT<int64_t>;
+#endif  /* __SIZEOF_INT128__ */
+//===================================================================
@@ -0,0 +1,210 @@
+// MeetKernel.cpp - The block segment tests of MeetKernel.h
+// Each kernel works out, a vector of lanes at a time, the four isLeft()
+// determinants of E_meet() and whether each is sure: whose sign it is
+// and which are sure come back as bit masks, and the answer is made from
+// those in K_answer(), the same for every kernel.  The file is built
+// without floating point contraction, so that every kernel rounds as
+// isLeft() does.
+
+#include <stdint.h>
+#include <float.h>
+#include <math.h>
+#include "MeetKernel.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define MEET_X86
+#include <immintrin.h>
+#endif
+
+// a determinant is sure if it is further from 0 than this times the sum
+// of its two products' magnitudes: twice the round-off it can have
+static const double BOUND = (3.0 + 16.0 * DBL_EPSILON) * DBL_EPSILON;
+
+// K_answer(): the hit and unsure bits of a run of lanes, from the sign
+// bits of determinants d1..d4 and the bits saying which are sure: q's
+// end points either side of the candidate (d3, d4) and the candidate's
+// either side of q (d1, d2) is a hit; both of either pair on one side
+// is a miss
+static inline void K_answer( uint64_t s1, uint64_t s2, uint64_t s3, uint64_t s4,
+                             uint64_t c1, uint64_t c2, uint64_t c3, uint64_t c4,
+                             uint64_t lanes, uint64_t &hit, uint64_t &unsure )
+{
+    uint64_t sure12 = c1 & c2, sure34 = c3 & c4;
+    uint64_t miss = (sure12 & ~(s1 ^ s2)) | (sure34 & ~(s3 ^ s4));
+    uint64_t h = sure12 & sure34 & (s1 ^ s2) & (s3 ^ s4);
+    hit = h & lanes;
+    unsure = ~(h | miss) & lanes;
+}
+
+// K_lane(): the determinants of lane i, one at a time
+static inline void K_lane( const double q[4], double lx, double ly,
+                           double rx, double ry, uint64_t s[4], uint64_t c[4] )
+{
+    double l[4], r[4];
+    double qdx = q[2] - q[0], qdy = q[3] - q[1];
+    double cdx = rx - lx, cdy = ry - ly;
+    l[0] = qdx * (ly - q[1]);   r[0] = (lx - q[0]) * qdy;
+    l[1] = qdx * (ry - q[1]);   r[1] = (rx - q[0]) * qdy;
+    l[2] = cdx * (q[1] - ly);   r[2] = (q[0] - lx) * cdy;
+    l[3] = cdx * (q[3] - ly);   r[3] = (q[2] - lx) * cdy;
+    for (int k=0; k < 4; k++) {
+        double d = l[k] - r[k];
+        s[k] = d < 0;
+        c[k] = fabs(d) > BOUND * (fabs(l[k]) + fabs(r[k]));
+    }
+}
+
+static void K_scalar( const double q[4], const double* lx, const double* ly,
+                      const double* rx, const double* ry, int n,
+                      uint64_t* hit, uint64_t* unsure )
+{
+    uint64_t S[4] = { 0 }, C[4] = { 0 };
+    for (int i=0; i < n; i++) {
+        uint64_t s[4], c[4];
+        K_lane(q, lx[i], ly[i], rx[i], ry[i], s, c);
+        for (int k=0; k < 4; k++) {
+            S[k] |= s[k] << i;
+            C[k] |= c[k] << i;
+        }
+    }
+    uint64_t lanes = (n < 64) ? ((uint64_t)1 << n) - 1 : ~(uint64_t)0;
+    K_answer(S[0], S[1], S[2], S[3], C[0], C[1], C[2], C[3], lanes, *hit, *unsure);
+}
+//===================================================================
+
+
+#ifdef MEET_X86
+
+// K_VECTOR(): the kernel body for W lanes of vector type V.  LOAD, SUB,
+// MUL, ABS, SET1 and the comparisons are the instruction set's; SIGN(d)
+// and SURE(d, l, r) give a lane mask.  The last vector may run past n,
+// into the padding, and its lanes there are masked off at the end.
+#define K_VECTOR(W, V)                                                  \
+    uint64_t S[4] = { 0 }, C[4] = { 0 };                                \
+    V qlx = SET1(q[0]), qly = SET1(q[1]);                               \
+    V qrx = SET1(q[2]), qry = SET1(q[3]);                               \
+    V qdx = SET1(q[2] - q[0]), qdy = SET1(q[3] - q[1]);                 \
+    V bound = SET1(BOUND);                                              \
+    for (int i=0; i < n; i += W) {                                      \
+        V clx = LOAD(lx + i), cly = LOAD(ly + i);                       \
+        V crx = LOAD(rx + i), cry = LOAD(ry + i);                       \
+        V cdx = SUB(crx, clx), cdy = SUB(cry, cly);                     \
+        V l[4], r[4];                                                   \
+        l[0] = MUL(qdx, SUB(cly, qly));  r[0] = MUL(SUB(clx, qlx), qdy); \
+        l[1] = MUL(qdx, SUB(cry, qly));  r[1] = MUL(SUB(crx, qlx), qdy); \
+        l[2] = MUL(cdx, SUB(qly, cly));  r[2] = MUL(SUB(qlx, clx), cdy); \
+        l[3] = MUL(cdx, SUB(qry, cly));  r[3] = MUL(SUB(qrx, clx), cdy); \
+        for (int k=0; k < 4; k++) {                                     \
+            V d = SUB(l[k], r[k]);                                      \
+            S[k] |= (uint64_t)SIGN(d) << i;                             \
+            C[k] |= (uint64_t)SURE(d, l[k], r[k]) << i;                 \
+        }                                                               \
+    }                                                                   \
+    uint64_t lanes = (n < 64) ? ((uint64_t)1 << n) - 1 : ~(uint64_t)0;  \
+    K_answer(S[0], S[1], S[2], S[3], C[0], C[1], C[2], C[3], lanes,     \
+             *hit, *unsure)
+
+#define SET1            _mm_set1_pd
+#define LOAD            _mm_loadu_pd
+#define SUB             _mm_sub_pd
+#define MUL             _mm_mul_pd
+#define ABS(d)          _mm_andnot_pd(_mm_set1_pd(-0.0), d)
+#define SIGN(d)         _mm_movemask_pd(d)
+#define SURE(d, l, r)   _mm_movemask_pd(_mm_cmpgt_pd(ABS(d), \
+                            _mm_mul_pd(bound, _mm_add_pd(ABS(l), ABS(r)))))
+
+__attribute__((target("sse2")))
+static void K_sse2( const double q[4], const double* lx, const double* ly,
+                    const double* rx, const double* ry, int n,
+                    uint64_t* hit, uint64_t* unsure )
+{
+    K_VECTOR(2, __m128d);
+}
+
+#undef SET1
+#undef LOAD
+#undef SUB
+#undef MUL
+#undef ABS
+#undef SIGN
+#undef SURE
+#define SET1            _mm256_set1_pd
+#define LOAD            _mm256_loadu_pd
+#define SUB             _mm256_sub_pd
+#define MUL             _mm256_mul_pd
+#define ABS(d)          _mm256_andnot_pd(_mm256_set1_pd(-0.0), d)
+#define SIGN(d)         _mm256_movemask_pd(d)
+#define SURE(d, l, r)   _mm256_movemask_pd(_mm256_cmp_pd(ABS(d), \
+                            _mm256_mul_pd(bound, _mm256_add_pd(ABS(l), ABS(r))), \
+                            _CMP_GT_OQ))
+
+__attribute__((target("avx2")))
+static void K_avx2( const double q[4], const double* lx, const double* ly,
+                    const double* rx, const double* ry, int n,
+                    uint64_t* hit, uint64_t* unsure )
+{
+    K_VECTOR(4, __m256d);
+}
+
+#undef SET1
+#undef LOAD
+#undef SUB
+#undef MUL
+#undef ABS
+#undef SIGN
+#undef SURE
+#define SET1            _mm512_set1_pd
+#define LOAD            _mm512_loadu_pd
+#define SUB             _mm512_sub_pd
+#define MUL             _mm512_mul_pd
+#define ABS(d)          _mm512_abs_pd(d)
+#define SIGN(d)         _mm512_cmp_pd_mask(d, _mm512_setzero_pd(), _CMP_LT_OQ)
+#define SURE(d, l, r)   _mm512_cmp_pd_mask(ABS(d), \
+                            _mm512_mul_pd(bound, _mm512_add_pd(ABS(l), ABS(r))), \
+                            _CMP_GT_OQ)
+
+__attribute__((target("avx512f")))
+static void K_avx512( const double q[4], const double* lx, const double* ly,
+                      const double* rx, const double* ry, int n,
+                      uint64_t* hit, uint64_t* unsure )
+{
+    K_VECTOR(8, __m512d);
+}
+
+#endif  /* MEET_X86 */
+//===================================================================
+
+
+KernelIsa best_Isa()
+{
+#ifdef MEET_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f"))
+        return ISA_AVX512;
+    if (__builtin_cpu_supports("avx2"))
+        return ISA_AVX2;
+    if (__builtin_cpu_supports("sse2"))
+        return ISA_SSE2;
+#endif
+    return ISA_SCALAR;
+}
+
+MeetKernel meet_Kernel( KernelIsa isa )
+{
+    if (isa > best_Isa())
+        return (MeetKernel)0;
+    switch (isa) {
+#ifdef MEET_X86
+    case ISA_AVX512:
+        return K_avx512;
+    case ISA_AVX2:
+        return K_avx2;
+    case ISA_SSE2:
+        return K_sse2;
+#endif
+    case ISA_SCALAR:
+        return K_scalar;
+    default:
+        return (MeetKernel)0;
+    }
+}
@@ -0,0 +1,49 @@
+// MeetKernel.h - Test one segment against a block of others at once
+// The E_meet() test (EventQueue.h) of one query segment against up to 64
+// candidates laid out in separate arrays of their end point coordinates,
+// one SIMD lane a candidate.  Its four isLeft() signs are found with the
+// same arithmetic as isLeft(), and a lane is only answered if all the
+// signs it needs are further from 0 than their worst case round-off
+// (the error bound of Shewchuk's orient2d); the rest, touching and
+// collinear pairs among them, are left for the caller to decide with
+// E_meet() itself.  So the answers are the scalar ones, on any data.
+//
+// The kernel is picked at run time for the machine (CPUID): AVX-512,
+// AVX2 or SSE2 on x86, plain C++ elsewhere.
+
+#ifndef MEETKERNEL_H
+#define MEETKERNEL_H
+
+#include <stdint.h>
+
+// the instruction sets there are kernels for
+enum KernelIsa {
+    ISA_SCALAR,            // plain C++, one lane at a time
+    ISA_SSE2,              // 2 lanes
+    ISA_AVX2,              // 4 lanes
+    ISA_AVX512,            // 8 lanes
+    ISA_KINDS
+};
+
+#define KERNEL_PAD 8       // the most lanes a kernel reads at once
+
+// MeetKernel: test segment q = (q[0],q[1])-(q[2],q[3]) against segments
+// (lx[i],ly[i])-(rx[i],ry[i]), for i < n <= 64, all given left point
+// first in xy order.  The arrays are read in whole vectors, up to
+// KERNEL_PAD-1 entries past n, which must be there but are ignored.
+//     Output: *hit,    bit i set if segment i surely meets q
+//             *unsure, bit i set if it is too close to call
+//     A segment with neither bit set surely does not meet q.
+typedef void (*MeetKernel)( const double q[4], const double* lx,
+                            const double* ly, const double* rx,
+                            const double* ry, int n, uint64_t* hit,
+                            uint64_t* unsure );
+
+// best_Isa(): the widest instruction set this machine has a kernel for
+KernelIsa best_Isa();
+
+// meet_Kernel(): the kernel for instruction set isa, or 0 if it was not
+// built in or this machine does not have it
+MeetKernel meet_Kernel( KernelIsa isa );
+
+#endif  /* MEETKERNEL_H */
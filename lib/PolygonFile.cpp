@@ -0,0 +1,159 @@
+// PolygonFile.cpp - Read and write SLP files (PolygonFile.h)
+// A file is mapped with mmap(), so its pages are only read in as the
+// sweeps get to them, and are shared by every thread sweeping it.
+
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+#include <limits.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "PolygonFile.h"
+
+static const char   MAGIC[4] = { 'S', 'L', 'P', '1' };
+static const size_t HEAD = 32;     // bytes before V[]
+
+static void P_fail( const char* path, const char* why )
+{
+    throw std::runtime_error(std::string(path) + ": " + why);
+}
+
+// P_check(): the reason the mapped file is not a sound SLP file, or 0
+static const char* P_check( const char* m, size_t size, int64_t &np,
+                            int64_t &ns, int64_t &nv, const uint64_t* &V,
+                            const uint64_t* &R, const int32_t* &S,
+                            const double* &XY )
+{
+    uint32_t one = 1;
+    if (*(const char*)&one != 1)
+        return "SLP files are little endian, and this machine is not";
+    uint32_t coord;
+    uint64_t n[3];
+    if (size < HEAD || memcmp(m, MAGIC, 4) != 0)
+        return "not an SLP file";
+    memcpy(&coord, m + 4, 4);
+    memcpy(n, m + 8, sizeof(n));
+    if (coord != sizeof(double))
+        return "coordinates are not doubles";
+    if (n[0] >= size || n[1] > size || n[2] > size)
+        return "file is too short";          // and the sums can't overflow
+    np = (int64_t)n[0];
+    ns = (int64_t)n[1];
+    nv = (int64_t)n[2];
+
+    size_t off = HEAD + 2 * 8 * (size_t)(np + 1);
+    size_t xy = off + 4 * (size_t)ns;
+    xy = (xy + 7) & ~(size_t)7;
+    if (size < xy || (size - xy) / 16 < (size_t)nv)
+        return "file is too short";
+    V = (const uint64_t*)(m + HEAD);
+    R = V + (np + 1);
+    S = (const int32_t*)(m + off);
+    XY = (const double*)(m + xy);
+
+    if (V[0] != 0 || V[np] != (uint64_t)nv || R[0] != 0 || R[np] != (uint64_t)ns)
+        return "bad polygon table";
+    for (int64_t i=0; i < np; i++) {
+        if (V[i+1] < V[i] || V[i+1] - V[i] > INT_MAX)
+            return "bad polygon table";
+        if (R[i+1] < R[i] + 2 || R[i+1] > (uint64_t)ns)
+            return "bad polygon table";
+        int32_t n = (int32_t)(V[i+1] - V[i]);
+        const int32_t* s = S + R[i];
+        int    nr = (int)(R[i+1] - R[i] - 1);
+        if (s[0] != 0 || s[nr] != n)
+            return "bad ring starts";
+        for (int k=0; k < nr; k++)
+            if (s[k+1] - s[k] < 3)
+                return "a ring has fewer than 3 vertices";
+    }
+    return (const char*)0;
+}
+
+PolygonFile::PolygonFile( const char* path )
+{
+    int fd = open(path, O_RDONLY);
+    if (fd < 0)
+        P_fail(path, strerror(errno));
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        int e = errno;
+        close(fd);
+        P_fail(path, strerror(e));
+    }
+    size = (size_t)st.st_size;
+    if (size < HEAD) {
+        close(fd);
+        P_fail(path, "not an SLP file");
+    }
+    map = mmap(0, size, PROT_READ, MAP_SHARED, fd, 0);
+    int e = errno;
+    close(fd);
+    if (map == MAP_FAILED)
+        P_fail(path, strerror(e));
+
+    const char* why = P_check((const char*)map, size, np, ns, nv, V, R, S, XY);
+    if (why) {
+        munmap(map, size);
+        P_fail(path, why);
+    }
+}
+
+PolygonFile::~PolygonFile()
+{
+    munmap(map, size);
+}
+
+Polygon* PolygonFile::View( int64_t i ) const
+{
+    const double* xy = XY + 2 * V[i];
+    int n = (int)(V[i+1] - V[i]);
+    int nr = (int)(R[i+1] - R[i] - 1);
+    Polygon* P = new Polygon(xy, xy + 1, n, 2 * sizeof(double));
+    if (nr > 1)
+        P->SetRings((const int*)(S + R[i]), nr);
+    return P;
+}
+
+void write_Polygons( const char* path, Polygon* const P[], int np )
+{
+    std::vector<uint64_t> V(np + 1), R(np + 1);
+    std::vector<int32_t>  S;
+    for (int i=0; i < np; i++) {
+        V[i+1] = V[i] + P[i]->n;
+        for (int k=0; k < P[i]->nr; k++)
+            S.push_back(P[i]->RingStart(k));
+        S.push_back(P[i]->n);
+        R[i+1] = S.size();
+    }
+    uint32_t coord = sizeof(double);
+    uint64_t n[3] = { (uint64_t)np, (uint64_t)S.size(), V[np] };
+    static const char pad[8] = { 0 };
+    size_t   npad = (8 - 4 * S.size() % 8) % 8;
+
+    FILE* f = fopen(path, "wb");
+    if (!f)
+        P_fail(path, strerror(errno));
+    fwrite(MAGIC, 1, 4, f);
+    fwrite(&coord, 4, 1, f);
+    fwrite(n, 8, 3, f);
+    fwrite(&V[0], 8, V.size(), f);
+    fwrite(&R[0], 8, R.size(), f);
+    if (!S.empty())
+        fwrite(&S[0], 4, S.size(), f);
+    fwrite(pad, 1, npad, f);
+    for (int i=0; i < np; i++)
+        for (int j=0; j < P[i]->n; j++) {
+            Point p = P[i]->Vertex(j);
+            double xy[2] = { p.x, p.y };
+            fwrite(xy, 8, 2, f);
+        }
+    bool bad = ferror(f) != 0;
+    if (fclose(f) != 0 || bad)
+        P_fail(path, "cannot write the file");
+}
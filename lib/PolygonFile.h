@@ -0,0 +1,57 @@
+// PolygonFile.h - Polygons in a binary file, mapped into memory
+// The file holds a batch of polygons laid out so that each one can be
+// swept where it lies, as a Polygon view onto the mapped file, with
+// nothing parsed or copied.  It is, all little endian:
+//
+//     char     magic[4];      "SLP1"
+//     uint32_t coord;         bytes a coordinate: 8, for double
+//     uint64_t np;            number of polygons
+//     uint64_t ns;            number of ring starts, in all
+//     uint64_t nv;            number of vertices, in all
+//     uint64_t V[np+1];       polygon i is vertices V[i] to V[i+1]-1
+//     uint64_t R[np+1];       and its ring starts are S[R[i]] to S[R[i+1]-1]
+//     int32_t  S[ns];         ring starts, from 0 to the polygon's n
+//     (0 to 4 zero bytes, to an 8 byte boundary)
+//     double   XY[nv][2];     the vertices, x y x y ...
+//
+// A polygon of one ring has ring starts 0, n.  Every ring must have at
+// least 3 vertices, and a polygon at most 2^31-1 of them.
+
+#ifndef POLYGONFILE_H
+#define POLYGONFILE_H
+
+#include <stdint.h>
+#include "simple_polygon.h"
+
+// PolygonFile: an SLP file mapped read only, checked when it is opened
+// so that no polygon of it can reach outside it
+class PolygonFile {
+public:
+    PolygonFile(const char* path);      // throws std::runtime_error
+    ~PolygonFile();
+
+    int64_t  Count() const { return np; }
+    int64_t  Vertices() const { return nv; }
+
+    // a new view of polygon i, for as long as the file is open; the
+    // caller deletes it
+    Polygon* View( int64_t i ) const;
+
+private:
+    void*    map;          // the whole file
+    size_t   size;
+    int64_t  np, ns, nv;
+    const uint64_t* V;
+    const uint64_t* R;
+    const int32_t*  S;
+    const double*   XY;
+
+    PolygonFile(const PolygonFile &);
+    PolygonFile & operator=(const PolygonFile &);
+};
+
+// write_Polygons(): write the polygons P[np] to an SLP file
+//     Throws std::runtime_error if the file cannot be written
+void write_Polygons( const char* path, Polygon* const P[], int np );
+
+#endif  /* POLYGONFILE_H */
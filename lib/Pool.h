@@ -0,0 +1,118 @@
+// Pool.h - Fixed size block allocation for the sweep's small objects
+
+#ifndef POOL_H
+#define POOL_H
+
+#include <stddef.h>
+#include <stdlib.h>
+#include <new>
+#include <vector>
+
+// Class "Pool" hands out blocks of one size, carved from chunks that it
+// mallocs as it needs them (each twice the size of the last). Freed blocks
+// go on a free list for reuse, and Reset() makes every chunk free again,
+// so a Pool that is reset between jobs stops calling malloc once it has
+// grown to fit the largest of them.
+//
+class Pool {
+public:
+   Pool(size_t blockSize, size_t firstChunk=64);
+   ~Pool();
+
+     // Get a block of at least the given size, or NULL if it is too big
+   void * Alloc(size_t size);
+
+     // Return a block to the pool
+   void Free(void * block);
+
+     // Make every block free again, keeping the memory
+   void Reset();
+
+   size_t BlockSize() const { return  mySize; }
+
+private:
+   struct FreeBlock { FreeBlock * next; };
+   struct Chunk { char * mem; size_t blocks; };
+
+   size_t  mySize;               // bytes per block
+   size_t  myFirst;              // blocks in the first chunk
+   std::vector<Chunk> myChunks;  // all chunks malloc'd so far
+   size_t  myChunk;              // index of the chunk being carved up
+   size_t  myUsed;               // blocks carved from it so far
+   FreeBlock * myFree;           // blocks given back since the last Reset
+
+   // Disallow copying and assignment
+   Pool(const Pool &);
+   Pool & operator=(const Pool &);
+};
+
+inline
+Pool::Pool(size_t blockSize, size_t firstChunk)
+   : myFirst(firstChunk), myChunk(0), myUsed(0), myFree(NULL)
+{
+   // keep every block aligned for doubles and pointers
+   const size_t align = sizeof(double) > sizeof(void*) ? sizeof(double)
+                                                        : sizeof(void*);
+   if (blockSize < sizeof(FreeBlock)) blockSize = sizeof(FreeBlock);
+   mySize = (blockSize + align - 1) / align * align;
+}
+
+inline
+Pool::~Pool() {
+   for (size_t i = 0; i < myChunks.size(); i++)
+      free(myChunks[i].mem);
+}
+
+inline void *
+Pool::Alloc(size_t size) {
+   if (size > mySize) return  NULL;
+
+   if (myFree) {
+      FreeBlock * block = myFree;
+      myFree = block->next;
+      return  block;
+   }
+   if ((myChunk < myChunks.size()) && (myUsed == myChunks[myChunk].blocks)) {
+      myChunk++;                 // this one's used up, move to the next
+      myUsed = 0;
+   }
+   if (myChunk == myChunks.size()) {
+      Chunk c;
+      c.blocks = (myChunks.empty()) ? myFirst : 2 * myChunks.back().blocks;
+      c.mem = (char *)malloc(c.blocks * mySize);
+      if (c.mem == NULL) throw std::bad_alloc();
+      myChunks.push_back(c);
+   }
+   return  myChunks[myChunk].mem + mySize * myUsed++;
+}
+
+inline void
+Pool::Free(void * block) {
+   if (block == NULL) return;
+   FreeBlock * f = (FreeBlock *)block;
+   f->next = myFree;
+   myFree = f;
+}
+
+inline void
+Pool::Reset() {
+   myChunk = 0;
+   myUsed = 0;
+   myFree = NULL;
+}
+
+// AVL tree nodes are allocated from the Pool AvlArena points to, or
+// from the heap while it is NULL. A tree must be emptied under the same
+// setting it was filled under.
+#define CUSTOM_ALLOCATE
+extern thread_local Pool * AvlArena;
+
+// Class "ArenaScope" points AvlArena at a pool for the life of the object
+class ArenaScope {
+   Pool * mySaved;
+public:
+   ArenaScope(Pool & pool) : mySaved(AvlArena) { AvlArena = &pool; }
+   ~ArenaScope() { AvlArena = mySaved; }
+};
+
+#endif  /* POOL_H */
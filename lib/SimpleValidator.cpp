@@ -0,0 +1,415 @@
+// SimpleValidator.cpp - simple_Polygon() kept up to date through edits
+// A polygon is simple when no two of its edges that are not consecutive
+// around a ring meet, and none has zero length: the test P_brute() makes
+// of small polygons.  Here the pairs that meet are kept, and an edit
+// only changes the pairs of the one or two edges it moves, adds or takes
+// out, and of an edge whose neighbours around its ring change.
+// The candidates for an edge are found in a bounding volume hierarchy
+// of the edges' boxes.  A uniform grid will not do: edges of very
+// different lengths, or crowded into a small part of the polygon's box,
+// as those of a star are round its middle, put most of them in a few
+// cells.
+
+#include <math.h>
+#include <algorithm>
+#include "EventQueue.h"
+#include "SimpleValidator.h"
+
+#define LEAF_EDGES  8      // edges in a leaf of the tree, when it is built
+
+// G_erase(): take one e out of list L, in any order
+static inline void G_erase( std::vector<int> &L, int e )
+{
+    std::vector<int>::iterator it = std::find(L.begin(), L.end(), e);
+    if (it != L.end()) {
+        *it = L.back();
+        L.pop_back();
+    }
+}
+
+template <class T>
+SimpleValidatorT<T>::SimpleValidatorT( const PolygonT<T> &Pn )
+    : nv(Pn.n), nbad(0), nzero(0), edits(0), search(0), edit(0)
+{
+    V.resize(nv);
+    next.resize(nv);
+    prev.resize(nv);
+    ring.resize(nv);
+    hits.resize(nv);
+    leafOf.resize(nv);
+    seen.assign(nv, 0);
+    done.assign(nv, 0);
+    for (int k=0; k < Pn.nr; k++) {
+        int a = Pn.RingStart(k);
+        int b = Pn.RingEnd(k);
+        for (int i=a; i < b; i++) {
+            V[i] = Pn.Vertex(i);
+            next[i] = (i+1 < b) ? i+1 : a;
+            prev[i] = (i > a) ? i-1 : b-1;
+            ring[i] = k;
+        }
+        rsize.push_back(b - a);
+    }
+
+    build();
+    edit++;
+    for (int e=0; e < nv; e++)
+        if (xyorder(&V[e], &V[next[e]]) == 0)
+            nzero++;
+    // one sweep answers for all the pairs of a simple polygon, there being
+    // none; they are only looked for one edge at a time if there are some
+    if (nv >= 3 && !simple_Polygon(const_cast<PolygonT<T>&>(Pn)))  // only read
+        for (int e=0; e < nv; e++)
+            pair(e);
+}
+
+// the bounding box of edge e.  Converting the coordinates to double keeps
+// their order, so edges that meet have boxes that overlap.
+template <class T>
+typename SimpleValidatorT<T>::Box SimpleValidatorT<T>::box( int e ) const
+{
+    PointT<T> a = V[e], b = V[next[e]];
+    Box B;
+    B.x0 = (double)std::min(a.x, b.x);
+    B.y0 = (double)std::min(a.y, b.y);
+    B.x1 = (double)std::max(a.x, b.x);
+    B.y1 = (double)std::max(a.y, b.y);
+    return B;
+}
+
+// an empty box, which overlaps nothing; the union of two boxes; and if
+// two boxes overlap (Box being SimpleValidatorT<T>::Box)
+template <class Box>
+static inline Box B_empty()
+{
+    Box b = { HUGE_VAL, HUGE_VAL, -HUGE_VAL, -HUGE_VAL };
+    return b;
+}
+
+template <class Box>
+static inline Box B_union( const Box &a, const Box &b )
+{
+    Box u = { std::min(a.x0, b.x0), std::min(a.y0, b.y0),
+              std::max(a.x1, b.x1), std::max(a.y1, b.y1) };
+    return u;
+}
+
+template <class Box>
+static inline bool B_overlap( const Box &a, const Box &b )
+{
+    return a.x0 <= b.x1 && b.x0 <= a.x1 && a.y0 <= b.y1 && b.y0 <= a.y1;
+}
+
+// the area of box b, and half its perimeter; 0 if it is empty
+template <class Box>
+static inline double B_area( const Box &b )
+{
+    return (b.x0 <= b.x1) ? (b.x1 - b.x0) * (b.y1 - b.y0) : 0;
+}
+
+template <class Box>
+static inline double B_side( const Box &b )
+{
+    return (b.x0 <= b.x1) ? (b.x1 - b.x0) + (b.y1 - b.y0) : 0;
+}
+
+// if the line through a and b, of direction d = b - a, surely passes
+// by box b: all four corners on one side of it, by more than the
+// round-off in working it out, and in converting the coordinates
+static inline bool B_missed( double ax, double ay, double dx, double dy,
+                             double x0, double y0, double x1, double y1 )
+{
+    double lo = HUGE_VAL, hi = -HUGE_VAL, tol = 0;
+    double X[2] = { x0, x1 }, Y[2] = { y0, y1 };
+    for (int i=0; i < 2; i++)
+        for (int j=0; j < 2; j++) {
+            double l = dx * (Y[j] - ay), r = (X[i] - ax) * dy;
+            double s = l - r;
+            lo = std::min(lo, s);
+            hi = std::max(hi, s);
+            tol = std::max(tol, fabs(dx) * (fabs(Y[j]) + fabs(ay))
+                              + fabs(dy) * (fabs(X[i]) + fabs(ax)));
+        }
+    tol *= 1e-12;
+    return lo > tol || hi < -tol;
+}
+
+// the tree over edges E[ne], below node 'up': split at the median of the
+// box centres, along whichever way gives the two halves' boxes the least
+// area (then perimeter, for edges all in a line).  The way the centres
+// spread most will not do for long edges: the teeth of a comb spread
+// most along their length.
+template <class T>
+int SimpleValidatorT<T>::split( int* E, int ne, int up )
+{
+    int  nd = (int)tree.size();
+    Node N;
+    N.b = B_empty<Box>();
+    N.up = up;
+    N.kid[0] = N.kid[1] = -1;
+    N.leaf = -1;
+    tree.push_back(N);
+
+    if (ne <= LEAF_EDGES) {
+        tree[nd].leaf = (int)leaves.size();
+        leaves.push_back(std::vector<int>(E, E + ne));
+        leafNode.push_back(nd);
+        for (int k=0; k < ne; k++)
+            leafOf[E[k]] = tree[nd].leaf;
+        tree[nd].b = leafBox(tree[nd].leaf);
+        return nd;
+    }
+
+    struct ByCentre {
+        const SimpleValidatorT* SV;
+        bool y;
+        bool operator()( int e, int f ) const {
+            Box a = SV->box(e), b = SV->box(f);
+            return y ? a.y0 + a.y1 < b.y0 + b.y1 : a.x0 + a.x1 < b.x0 + b.x1;
+        }
+    };
+    int    m = ne / 2;
+    double area[2], side[2];
+    for (int y=0; y < 2; y++) {
+        ByCentre less = { this, y == 1 };
+        std::nth_element(E, E + m, E + ne, less);
+        Box h[2] = { B_empty<Box>(), B_empty<Box>() };
+        for (int k=0; k < ne; k++)
+            h[k >= m] = B_union(h[k >= m], box(E[k]));
+        area[y] = B_area(h[0]) + B_area(h[1]);
+        side[y] = B_side(h[0]) + B_side(h[1]);
+    }
+    if (area[0] < area[1] || (area[0] == area[1] && side[0] <= side[1])) {      // E is split along y now
+        ByCentre less = { this, false };
+        std::nth_element(E, E + m, E + ne, less);
+    }
+
+    int k0 = split(E, m, nd);
+    int k1 = split(E + m, ne - m, nd);
+    tree[nd].kid[0] = k0;
+    tree[nd].kid[1] = k1;
+    tree[nd].b = B_union(tree[k0].b, tree[k1].b);
+    return nd;
+}
+
+// build the tree again over all the edges there are now
+template <class T>
+void SimpleValidatorT<T>::build()
+{
+    std::vector<int> E;
+    for (int e=0; e < (int)V.size(); e++)
+        if (next[e] >= 0)
+            E.push_back(e);
+    tree.clear();
+    leaves.clear();
+    leafNode.clear();
+    edits = 0;
+    if (!E.empty())
+        split(&E[0], (int)E.size(), -1);
+}
+
+// the box of the edges in a leaf
+template <class T>
+typename SimpleValidatorT<T>::Box SimpleValidatorT<T>::leafBox( int leaf ) const
+{
+    Box b = B_empty<Box>();
+    const std::vector<int> &L = leaves[leaf];
+    for (size_t k=0; k < L.size(); k++)
+        b = B_union(b, box(L[k]));
+    return b;
+}
+
+// work out the box of a leaf again, and of the nodes above it, as far up
+// as they change
+template <class T>
+void SimpleValidatorT<T>::refit( int leaf )
+{
+    int  nd = leafNode[leaf];
+    Box  b = leafBox(leaf);
+    for (;;) {
+        Box &o = tree[nd].b;
+        if (o.x0 == b.x0 && o.y0 == b.y0 && o.x1 == b.x1 && o.y1 == b.y1)
+            break;         // nothing above it changes
+        o = b;
+        if ((nd = tree[nd].up) < 0)
+            break;
+        b = B_union(tree[tree[nd].kid[0]].b, tree[tree[nd].kid[1]].b);
+    }
+}
+
+// test edge e against every edge whose box overlaps its own and is not
+// passed by by e's line, but those already tested in this edit, and keep
+// the pairs that meet
+template <class T>
+void SimpleValidatorT<T>::pair( int e )
+{
+    PointT<T> a = V[e], b = V[next[e]];
+    PointT<T> lP = (xyorder(&a, &b) <= 0) ? a : b;
+    PointT<T> rP = (xyorder(&a, &b) <= 0) ? b : a;
+    Box      q = box(e);
+    double   ax = (double)a.x, ay = (double)a.y;
+    double   dx = (double)b.x - ax, dy = (double)b.y - ay;
+
+    search++;
+    seen[e] = search;
+    done[e] = edit;
+    C.clear();
+    int  stack[64 + 8 * sizeof(int)];
+    int  top = 0;
+    if (!tree.empty())
+        stack[top++] = 0;
+    while (top > 0) {
+        const Node &N = tree[stack[--top]];
+        if (!B_overlap(q, N.b)
+            || B_missed(ax, ay, dx, dy, N.b.x0, N.b.y0, N.b.x1, N.b.y1))
+            continue;
+        if (N.leaf >= 0) {
+            const std::vector<int> &L = leaves[N.leaf];
+            C.insert(C.end(), L.begin(), L.end());
+        }
+        else {
+            stack[top++] = N.kid[0];
+            stack[top++] = N.kid[1];
+        }
+    }
+
+    for (size_t k=0; k < C.size(); k++) {
+        int f = C[k];
+        if (seen[f] == search || done[f] == edit)
+            continue;
+        seen[f] = search;
+        if (next[e] == f || next[f] == e)
+            continue;      // consecutive: they only meet at their vertex
+        Box fb = box(f);
+        if (!B_overlap(q, fb)
+            || B_missed(ax, ay, dx, dy, fb.x0, fb.y0, fb.x1, fb.y1))
+            continue;
+        PointT<T> p = V[f], r = V[next[f]];
+        bool meet = (xyorder(&p, &r) <= 0) ? E_meet(lP, rP, p, r)
+                                           : E_meet(lP, rP, r, p);
+        if (meet) {
+            hits[e].push_back(f);
+            hits[f].push_back(e);
+            nbad++;
+        }
+    }
+}
+
+// forget the pairs edge e is in
+template <class T>
+void SimpleValidatorT<T>::unpair( int e )
+{
+    for (size_t k=0; k < hits[e].size(); k++)
+        G_erase(hits[hits[e][k]], e);
+    nbad -= (int64_t)hits[e].size();
+    hits[e].clear();
+}
+
+// an edit is about to change edges E[ne]
+template <class T>
+void SimpleValidatorT<T>::begin( const int* E, int ne )
+{
+    edit++;
+    for (int k=0; k < ne; k++) {
+        unpair(E[k]);
+        if (xyorder(&V[E[k]], &V[next[E[k]]]) == 0)
+            nzero--;
+    }
+}
+
+// an edit has changed edges E[ne], each now in its leaf
+template <class T>
+void SimpleValidatorT<T>::end( const int* E, int ne )
+{
+    for (int k=0; k < ne; k++) {
+        refit(leafOf[E[k]]);
+        if (xyorder(&V[E[k]], &V[next[E[k]]]) == 0)
+            nzero++;
+    }
+    for (int k=0; k < ne; k++)
+        pair(E[k]);
+    if (++edits > nv)
+        build();
+}
+
+// a vertex id for a new vertex
+template <class T>
+int SimpleValidatorT<T>::alloc()
+{
+    if (!freed.empty()) {
+        int v = freed.back();
+        freed.pop_back();
+        return v;
+    }
+    PointT<T> p = PointT<T>();
+    V.push_back(p);
+    next.push_back(-1);
+    prev.push_back(-1);
+    ring.push_back(0);
+    hits.push_back(std::vector<int>());
+    leafOf.push_back(-1);
+    seen.push_back(0);
+    done.push_back(0);
+    return (int)V.size() - 1;
+}
+
+template <class T>
+void SimpleValidatorT<T>::Move( int v, T x, T y )
+{
+    int E[2] = { prev[v], v };     // the edges into and out of v
+    begin(E, 2);
+    V[v].x = x;
+    V[v].y = y;
+    end(E, 2);
+}
+
+template <class T>
+int SimpleValidatorT<T>::Insert( int v, T x, T y )
+{
+    int u = alloc();
+    begin(&v, 1);                  // edge v becomes v to u
+    int w = next[v];
+    next[v] = u;
+    prev[u] = v;
+    next[u] = w;
+    prev[w] = u;
+    ring[u] = ring[v];
+    rsize[ring[v]]++;
+    nv++;
+    V[u].x = x;
+    V[u].y = y;
+    leafOf[u] = leafOf[v];         // edge u is where edge v was
+    leaves[leafOf[u]].push_back(u);
+    int E[2] = { v, u };
+    end(E, 2);
+    return u;
+}
+
+template <class T>
+bool SimpleValidatorT<T>::Delete( int v )
+{
+    if (rsize[ring[v]] <= 3)
+        return false;
+    int p = prev[v], w = next[v];
+    int E[2] = { p, v };           // edge p becomes p to w
+    begin(E, 2);
+    G_erase(leaves[leafOf[v]], v);
+    refit(leafOf[v]);
+    next[p] = w;
+    prev[w] = p;
+    next[v] = prev[v] = -1;
+    rsize[ring[v]]--;
+    nv--;
+    freed.push_back(v);
+    end(&p, 1);
+    return true;
+}
+
+// the coordinate types SimpleValidator is built for
+template class SimpleValidatorT<double>;
+template class SimpleValidatorT<float>;
+#ifdef __SIZEOF_INT128__
+template class SimpleValidatorT<int32_t>;
+template class SimpleValidatorT<int64_t>;
+#endif  /* __SIZEOF_INT128__ */
+//===================================================================
@@ -0,0 +1,98 @@
+// SimpleValidator.h - Keep simple_Polygon()'s answer as a polygon is edited
+// An editor that moves, inserts or deletes one vertex at a time need not
+// sweep the whole polygon again after each edit.  A SimpleValidator keeps
+// the polygon's edges in a tree of bounding boxes, and the pairs of them
+// that meet: an edit takes out the pairs of the edges it changed, and
+// tests those edges again against the ones whose boxes overlap theirs,
+// so it costs about as much as the edges near it, not the whole polygon.
+// Making one costs a simple_Polygon() sweep, and if that finds the
+// polygon is not simple, a search for the pairs round every edge.
+//
+//     SimpleValidator SV(P);              // P's vertices are ids 0..n-1
+//     SV.Move(17, x, y);
+//     int v = SV.Insert(17, x, y);        // a new vertex after 17
+//     SV.Delete(v);
+//     bool simple = SV.Simple();          // simple_Polygon() of it now
+//
+// Vertex ids stay the same through edits; a deleted vertex's id may be
+// reused by a later Insert().  Edge v is from vertex v to Next(v).
+
+#ifndef SIMPLEVALIDATOR_H
+#define SIMPLEVALIDATOR_H
+
+#include <stdint.h>
+#include <vector>
+#include <unordered_map>
+#include "simple_polygon.h"
+
+template <class T>
+class SimpleValidatorT {
+public:
+    // a copy of Pn, vertex i of it being vertex id i
+    SimpleValidatorT(const PolygonT<T> &Pn);
+
+    // simple_Polygon() of the polygon as it is now
+    bool     Simple() const { return nv < 3 || (nbad == 0 && nzero == 0); }
+    int64_t  Pairs() const { return nbad; }     // pairs of edges that meet
+
+    void     Move( int v, T x, T y );           // move vertex v to x,y
+    int      Insert( int v, T x, T y );         // add one after v: its id
+    bool     Delete( int v );                   // false, and not deleted,
+                                                // if its ring has only 3
+
+    int      Vertices() const { return nv; }
+    PointT<T> Vertex( int v ) const { return V[v]; }
+    int      Next( int v ) const { return next[v]; }
+    int      Prev( int v ) const { return prev[v]; }
+
+private:
+    std::vector<PointT<T> > V;     // by vertex id
+    std::vector<int> next, prev;   // the vertices either side around its ring
+    std::vector<int> ring;         // the ring it is in
+    std::vector<int> rsize;        // vertices in each ring
+    std::vector<int> freed;        // ids of deleted vertices
+    int      nv;                   // vertices in all
+
+    std::vector<std::vector<int> > hits;   // hits[e], the edges edge e meets
+    int64_t  nbad;                 // pairs of edges that meet
+    int      nzero;                // edges of zero length
+
+    // the bounding volume hierarchy: a binary tree of boxes, split at the
+    // median down to leaves of a few edges.  An edit refits the boxes
+    // from its edges' leaves up, and the tree is built again once there
+    // have been as many edits as edges.
+    struct Box {
+        double   x0, y0, x1, y1;
+    };
+    struct Node {
+        Box      b;
+        int      kid[2];           // for an inner node
+        int      up;               // its parent, or -1 for the root
+        int      leaf;             // leaves[leaf] if a leaf, else -1
+    };
+    std::vector<Node> tree;        // tree[0] is the root
+    std::vector<std::vector<int> > leaves;  // the edges in each leaf
+    std::vector<int> leafNode;     // the node of each leaf
+    std::vector<int> leafOf;       // the leaf each edge is in
+    int64_t  edits;                // since the tree was built
+
+    std::vector<int> C;            // candidates for pair()
+    std::vector<unsigned> seen;    // the last search edge e was found in
+    std::vector<unsigned> done;    // the last edit edge e was tested in
+    unsigned search, edit;
+
+    Box      box( int e ) const;
+    Box      leafBox( int leaf ) const;
+    void     build();
+    int      split( int* E, int ne, int up );
+    void     refit( int leaf );
+    void     pair( int e );
+    void     unpair( int e );
+    void     begin( const int* E, int ne );
+    void     end( const int* E, int ne );
+    int      alloc();
+};
+
+typedef SimpleValidatorT<double> SimpleValidator;
+
+#endif  /* SIMPLEVALIDATOR_H */
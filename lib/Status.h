@@ -0,0 +1,442 @@
+// Status.h - Sweep line status trees
+// A status tree holds the segments crossing the sweep line in order from
+// below to above.  The sweep's segments link to their neighbours
+// themselves, so all a status tree has to do is find where a new one
+// goes in, and take out one it is handed.  Each kind is a class template
+// on the segment type Seg, with
+//
+//     Status( Pool &nodes, Pool &blocks );     // where its nodes come from
+//     void   Insert( Seg* s, Seg* &below, Seg* &above );
+//     void   Remove( Seg* s );
+//
+// Seg has a Compare(key) member (as for ItemComparable), 'above' and
+// 'below' links kept up to date by the caller, and a 'void* node' that is
+// the status tree's own.
+// The trees only compare a segment being inserted, so the order of the
+// segments need not be known any more when one is removed.
+
+#ifndef STATUS_H
+#define STATUS_H
+
+#include "Avl.h"
+#include "Pool.h"
+#include "SweepStats.h"
+
+// StatusAvl: the AVL tree, with nodes from AvlArena.  Seg must also have
+// 'gone' and 'toward', and Compare(key) must return key->toward when
+// key->gone: that is how Delete() is steered down to a node.
+template <class Seg>
+class StatusAvl {
+    typedef AvlNode<Seg*, ItemComparable<Seg*> > Tnode;
+
+    AvlTree<Seg*, ItemComparable<Seg*> > Tree;
+public:
+    enum { NODE_SIZE = sizeof(Tnode) };
+
+    StatusAvl( Pool &, Pool & ) {}
+
+    void Insert( Seg* s, Seg* &below, Seg* &above )
+    {
+        Tnode* nd = Tree.Insert(s);
+        Tnode* nx = Tree.Next(nd);
+        Tnode* np = Tree.Prev(nd);
+        s->node = nd;
+        above = nx ? nx->Key() : (Seg*)0;
+        below = np ? np->Key() : (Seg*)0;
+    }
+
+    void Remove( Seg* s )
+    {
+        // mark the way down to s's node for Delete() to follow
+        Tnode* c = (Tnode*)s->node;
+        for (Tnode* p = c->Parent(); p; c = p, p = p->Parent())
+            p->Key()->toward = (c == p->Subtree(Tnode::LEFT)) ? MIN_CMP : MAX_CMP;
+        s->gone = true;
+
+        // a node with two subtrees is kept and given its successor's data
+        Tnode* nd = (Tnode*)s->node;
+        bool moved = nd->Subtree(Tnode::LEFT) && nd->Subtree(Tnode::RIGHT);
+        if (Tree.Delete(s) != (Seg*)0 && moved)
+            s->above->node = nd;
+    }
+};
+
+// StatusRB: a red-black tree (Cormen et al., "Introduction to
+// Algorithms", ch. 13), as the Javascript sweep line uses.  It takes a
+// node out by relinking the tree around it, so it never searches on
+// removal.
+template <class Seg>
+class StatusRB {
+    struct Node {
+        Seg*     key;
+        Node*    sub[2];       // left (below) and right (above) subtrees
+        Node*    parent;       // NULL at the root
+        bool     red;
+    };
+
+    Node*    root;
+    Pool*    pool;
+
+    static bool isRed( const Node* x ) { return x && x->red; }
+    void     rotate( Node* x, int d );  // x goes down on side d
+    void     transplant( Node* u, Node* v );
+public:
+    enum { NODE_SIZE = sizeof(Node) };
+
+    StatusRB( Pool &nodes, Pool & ) : root((Node*)0), pool(&nodes) {}
+
+    void     Insert( Seg* s, Seg* &below, Seg* &above );
+    void     Remove( Seg* s );
+};
+
+template <class Seg>
+void StatusRB<Seg>::rotate( Node* x, int d )
+{
+    Node* c = x->sub[1-d];
+    STAT(rotate_once, 1);
+    x->sub[1-d] = c->sub[d];
+    if (c->sub[d])
+        c->sub[d]->parent = x;
+    c->parent = x->parent;
+    if (!x->parent)
+        root = c;
+    else
+        x->parent->sub[x == x->parent->sub[1]] = c;
+    c->sub[d] = x;
+    x->parent = c;
+}
+
+// put v (which may be NULL) where u is
+template <class Seg>
+void StatusRB<Seg>::transplant( Node* u, Node* v )
+{
+    if (!u->parent)
+        root = v;
+    else
+        u->parent->sub[u == u->parent->sub[1]] = v;
+    if (v)
+        v->parent = u->parent;
+}
+
+template <class Seg>
+void StatusRB<Seg>::Insert( Seg* s, Seg* &below, Seg* &above )
+{
+    // the last nodes passed on the right and left are s's neighbours
+    Node* p = (Node*)0;
+    int   d = 0;
+    below = above = (Seg*)0;
+    for (Node* x = root; x; x = x->sub[d]) {
+        STAT(insert_steps, 1);
+        p = x;
+        d = (x->key->Compare(s) == MIN_CMP) ? 0 : 1;
+        if (d == 0)
+            above = x->key;
+        else
+            below = x->key;
+    }
+
+    Node* z = (Node*)pool->Alloc(sizeof(Node));
+    z->key = s;
+    z->sub[0] = z->sub[1] = (Node*)0;
+    z->parent = p;
+    z->red = true;
+    if (!p)
+        root = z;
+    else
+        p->sub[d] = z;
+    s->node = z;
+
+    // restore the colouring: no red node has a red parent
+    while ((p = z->parent) && p->red) {
+        Node* g = p->parent;          // there is one: the root is black
+        int   pd = (p == g->sub[1]);
+        Node* u = g->sub[1-pd];
+        if (isRed(u)) {
+            p->red = u->red = false;
+            g->red = true;
+            z = g;
+            continue;
+        }
+        if (z == p->sub[1-pd]) {
+            z = p;
+            rotate(z, pd);
+            p = z->parent;
+        }
+        p->red = false;
+        g->red = true;
+        rotate(g, 1-pd);
+    }
+    root->red = false;
+}
+
+template <class Seg>
+void StatusRB<Seg>::Remove( Seg* s )
+{
+    Node* z = (Node*)s->node;
+    Node* x;                          // what moves up into the hole
+    Node* xp;                         // its parent, as x may be NULL
+    bool  wasRed = z->red;
+
+    if (!z->sub[0] || !z->sub[1]) {
+        x = z->sub[0] ? z->sub[0] : z->sub[1];
+        xp = z->parent;
+        transplant(z, x);
+    }
+    else {                            // z's successor y takes its place
+        Node* y = z->sub[1];
+        while (y->sub[0])
+            y = y->sub[0];
+        wasRed = y->red;
+        x = y->sub[1];
+        if (y->parent == z)
+            xp = y;
+        else {
+            xp = y->parent;
+            transplant(y, x);
+            y->sub[1] = z->sub[1];
+            y->sub[1]->parent = y;
+        }
+        transplant(z, y);
+        y->sub[0] = z->sub[0];
+        y->sub[0]->parent = y;
+        y->red = z->red;
+    }
+    pool->Free(z);
+    if (wasRed)
+        return;
+
+    // x is a black short on its side: move it up, or make it up there
+    while (x != root && !isRed(x)) {
+        int   d = (x == xp->sub[1]);
+        Node* w = xp->sub[1-d];       // there is one: it has the black
+        if (w->red) {
+            w->red = false;
+            xp->red = true;
+            rotate(xp, d);
+            w = xp->sub[1-d];
+        }
+        if (!isRed(w->sub[0]) && !isRed(w->sub[1])) {
+            w->red = true;
+            x = xp;
+            xp = x->parent;
+            continue;
+        }
+        if (!isRed(w->sub[1-d])) {
+            w->sub[d]->red = false;
+            w->red = true;
+            rotate(w, 1-d);
+            w = xp->sub[1-d];
+        }
+        w->red = xp->red;
+        xp->red = false;
+        w->sub[1-d]->red = false;
+        rotate(xp, d);
+        x = root;
+    }
+    if (x)
+        x->red = false;
+}
+
+// StatusBtree: a B+ tree holding up to B segments side by side in each
+// leaf, for fewer and more cache friendly node visits than a binary tree
+// on a wide sweep line.  An inner node keeps the lowest segment under
+// each of its children to search by.  Nodes are split when full, and
+// only freed once empty (no merging), so the tree stays shallow.
+template <class Seg>
+class StatusBtree {
+    enum { B = 32 };           // most entries in a node
+
+    struct Node {
+        Node*    parent;       // NULL at the root
+        int      n;            // entries in use
+        bool     leaf;
+        Seg*     lo[B];        // a leaf's segments, in order; or the
+                               // lowest segment under each child
+        Node*    sub[B];       // an inner node's children
+    };
+
+    Node*    root;
+    Pool*    pool;
+
+    Node*    newNode( bool leaf );
+    int      below( const Node* x, Seg* s ) const;  // entries below s
+    int      slot( const Node* up, const Node* x ) const;
+    void     put( Node* x, int p, Seg* s, Node* c );
+    void     take( Node* x, int p );
+    void     fixLo( Node* x );
+public:
+    enum { NODE_SIZE = sizeof(Node) };
+
+    StatusBtree( Pool &, Pool &blocks ) : root((Node*)0), pool(&blocks) {}
+
+    void     Insert( Seg* s, Seg* &below, Seg* &above );
+    void     Remove( Seg* s );
+};
+
+template <class Seg>
+typename StatusBtree<Seg>::Node* StatusBtree<Seg>::newNode( bool leaf )
+{
+    Node* x = (Node*)pool->Alloc(sizeof(Node));
+    x->parent = (Node*)0;
+    x->n = 0;
+    x->leaf = leaf;
+    return x;
+}
+
+template <class Seg>
+int StatusBtree<Seg>::below( const Node* x, Seg* s ) const
+{
+    int lo = 0, hi = x->n;
+    while (lo < hi) {
+        int m = (lo + hi) / 2;
+        if (x->lo[m]->Compare(s) == MIN_CMP)
+            hi = m;
+        else
+            lo = m + 1;
+    }
+    return lo;
+}
+
+// where x is among up's children
+template <class Seg>
+int StatusBtree<Seg>::slot( const Node* up, const Node* x ) const
+{
+    int k = 0;
+    while (up->sub[k] != x)
+        k++;
+    return k;
+}
+
+// x's lowest segment has changed: so has that of the parents it is the
+// first child of
+template <class Seg>
+void StatusBtree<Seg>::fixLo( Node* x )
+{
+    while (x->parent) {
+        Node* up = x->parent;
+        int   k = slot(up, x);
+        up->lo[k] = x->lo[0];
+        if (k > 0)
+            break;
+        x = up;
+    }
+}
+
+// put entry s (and child c, in an inner node) at index p of x,
+// splitting x first if it is full
+template <class Seg>
+void StatusBtree<Seg>::put( Node* x, int p, Seg* s, Node* c )
+{
+    if (x->n == B) {
+        Node* y = newNode(x->leaf);
+        int   h = B / 2;
+        y->n = B - h;
+        for (int i=0; i < y->n; i++) {
+            y->lo[i] = x->lo[h+i];
+            if (x->leaf)
+                y->lo[i]->node = y;
+            else {
+                y->sub[i] = x->sub[h+i];
+                y->sub[i]->parent = y;
+            }
+        }
+        x->n = h;
+
+        Node* up = x->parent;
+        if (!up) {                    // a new root above x
+            up = newNode(false);
+            up->n = 1;
+            up->lo[0] = x->lo[0];
+            up->sub[0] = x;
+            x->parent = up;
+            root = up;
+        }
+        put(up, slot(up, x) + 1, y->lo[0], y);
+        if (p > h) {
+            x = y;
+            p -= h;
+        }
+    }
+
+    for (int i = x->n; i > p; i--) {
+        x->lo[i] = x->lo[i-1];
+        if (!x->leaf)
+            x->sub[i] = x->sub[i-1];
+    }
+    x->lo[p] = s;
+    if (x->leaf)
+        s->node = x;
+    else {
+        x->sub[p] = c;
+        c->parent = x;
+    }
+    x->n++;
+    if (p == 0)
+        fixLo(x);
+}
+
+// take entry p out of x, and x out of its parent if that empties it
+template <class Seg>
+void StatusBtree<Seg>::take( Node* x, int p )
+{
+    x->n--;
+    for (int i = p; i < x->n; i++) {
+        x->lo[i] = x->lo[i+1];
+        if (!x->leaf)
+            x->sub[i] = x->sub[i+1];
+    }
+    if (x->n > 0) {
+        if (p == 0)
+            fixLo(x);
+        return;
+    }
+    Node* up = x->parent;
+    if (up)
+        take(up, slot(up, x));
+    else
+        root = (Node*)0;
+    pool->Free(x);
+}
+
+template <class Seg>
+void StatusBtree<Seg>::Insert( Seg* s, Seg* &below, Seg* &above )
+{
+    if (!root)
+        root = newNode(true);
+
+    // go down to the last child whose lowest segment is below s, or the
+    // first one if there is none
+    Node* x = root;
+    while (!x->leaf) {
+        STAT(insert_steps, 1);
+        int k = this->below(x, s);
+        x = x->sub[k > 0 ? k-1 : 0];
+    }
+    STAT(insert_steps, 1);
+    int p = this->below(x, s);
+
+    // s's neighbours: at p == 0 it goes in below all the others
+    below = (p > 0) ? x->lo[p-1] : (Seg*)0;
+    above = below ? below->above : (x->n ? x->lo[0] : (Seg*)0);
+    put(x, p, s, (Node*)0);
+}
+
+template <class Seg>
+void StatusBtree<Seg>::Remove( Seg* s )
+{
+    Node* x = (Node*)s->node;
+    int   p = 0;
+    while (x->lo[p] != s)
+        p++;
+    take(x, p);
+
+    // a root with one child is not needed
+    while (root && !root->leaf && root->n == 1) {
+        Node* r = root;
+        root = r->sub[0];
+        root->parent = (Node*)0;
+        pool->Free(r);
+    }
+}
+
+#endif  /* STATUS_H */
@@ -0,0 +1,49 @@
+// SweepStats.cpp - Adding up and printing SweepStats records
+
+#include <chrono>
+#include "SweepStats.h"
+
+thread_local SweepStats* SweepStatsNow = (SweepStats*)0;
+
+double stat_Clock()
+{
+    return std::chrono::duration<double, std::milli>(
+               std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void add_Stats( SweepStats &total, const SweepStats &s )
+{
+    total.calls += s.calls;
+    total.vertices += s.vertices;
+    total.quick += s.quick;
+    total.events += s.events;
+    total.advances += s.advances;
+    total.compares += s.compares;
+    total.isLefts += s.isLefts;
+    total.search_steps += s.search_steps;
+    total.insert_steps += s.insert_steps;
+    total.delete_steps += s.delete_steps;
+    total.parents += s.parents;
+    total.rotate_once += s.rotate_once;
+    total.rotate_twice += s.rotate_twice;
+    if (total.peak < s.peak)
+        total.peak = s.peak;
+    total.sort_ms += s.sort_ms;
+    total.sweep_ms += s.sweep_ms;
+    total.total_ms += s.total_ms;
+}
+
+void print_Stats( FILE* f, const SweepStats &s )
+{
+    fprintf(f, "calls=%lld vertices=%lld quick=%lld events=%lld advances=%lld "
+               "compares=%lld isLefts=%lld search_steps=%lld insert_steps=%lld "
+               "delete_steps=%lld parents=%lld rotate_once=%lld rotate_twice=%lld "
+               "peak=%lld sort_ms=%.3f sweep_ms=%.3f total_ms=%.3f\n",
+            (long long)s.calls, (long long)s.vertices, (long long)s.quick,
+            (long long)s.events, (long long)s.advances, (long long)s.compares,
+            (long long)s.isLefts, (long long)s.search_steps,
+            (long long)s.insert_steps, (long long)s.delete_steps,
+            (long long)s.parents, (long long)s.rotate_once,
+            (long long)s.rotate_twice, (long long)s.peak,
+            s.sort_ms, s.sweep_ms, s.total_ms);
+}
@@ -0,0 +1,110 @@
+// SweepStats.h - Counters and timers of what a sweep did
+// Built with SWEEP_STATS defined (cmake -DSWEEPLINE_STATS=ON),
+// simple_Polygon() fills in a SweepStats for each call made in a
+// SweepContext that has one, so that a polygon that takes far longer
+// than others of its size can be told apart, and a change to the sweep
+// measured by the work it saves:
+//
+//     SweepStats S;
+//     C.stats = &S;
+//     simple_Polygon(P, C);               // S is this call's record
+//     add_Stats(Total, S);
+//     print_Stats(stderr, Total);
+//
+// Without SWEEP_STATS the counting is not compiled in at all, and the
+// records are left as they are (all 0).
+
+#ifndef SWEEPSTATS_H
+#define SWEEPSTATS_H
+
+#include <stdio.h>
+#include <string.h>
+#include <stdint.h>
+
+struct SweepStats {
+    int64_t  calls;        // simple_Polygon() calls: 1 in one call's record
+    int64_t  vertices;     // in the polygons
+    int64_t  quick;        // calls answered without a sweep (convex, small)
+    int64_t  events;       // chain end events taken from the queue
+    int64_t  advances;     // chains stepped on to their next edge
+    int64_t  compares;     // segment comparisons in the status tree
+    int64_t  isLefts;      // isLeft() evaluations
+    int64_t  search_steps; // AVL nodes AvlNode::Search() went through
+    int64_t  insert_steps; // status tree nodes inserting went through
+    int64_t  delete_steps; // AVL nodes AvlNode::Delete() went through
+    int64_t  parents;      // AVL Parent() links followed
+    int64_t  rotate_once;  // AVL or red-black single rotations
+    int64_t  rotate_twice; // AVL double rotations
+    int64_t  peak;         // most chains in the status tree at once
+    double   sort_ms;      // sorting the events
+    double   sweep_ms;     // the sweep, after the sort
+    double   total_ms;     // the whole call
+
+    SweepStats() { memset(this, 0, sizeof(*this)); }
+};
+
+// add_Stats(): add record s to total; peak is the larger of the two
+void add_Stats( SweepStats &total, const SweepStats &s );
+
+// print_Stats(): s on one line of f, as name=value pairs
+void print_Stats( FILE* f, const SweepStats &s );
+
+// the record of the call this thread is in, if it is being kept
+extern thread_local SweepStats* SweepStatsNow;
+
+// stat_Clock(): milliseconds, for the timers
+double stat_Clock();
+
+#ifdef SWEEP_STATS
+
+// STAT(): add k to counter 'field' of the record being kept
+#define STAT(field, k)                                                  \
+    do {                                                                \
+        if (SweepStatsNow)                                              \
+            SweepStatsNow->field += (k);                                \
+    } while (0)
+
+// STAT_PEAK(): make counter 'field' at least v
+#define STAT_PEAK(field, v)                                             \
+    do {                                                                \
+        if (SweepStatsNow && SweepStatsNow->field < (v))                \
+            SweepStatsNow->field = (v);                                 \
+    } while (0)
+
+// StatTimer: add the milliseconds from here to Stop(), or to the end of
+// the scope, to timer 'field'
+class StatTimer {
+    double   SweepStats::*field;
+    double   t0;
+public:
+    StatTimer( double SweepStats::*f ) : field(f), t0(stat_Clock()) {}
+    ~StatTimer() { Stop(); }
+    void Stop()
+    {
+        if (SweepStatsNow && field)
+            SweepStatsNow->*field += stat_Clock() - t0;
+        field = 0;
+    }
+};
+
+// StatScope: count into record s (0: none) until the end of the scope
+class StatScope {
+    SweepStats* was;
+public:
+    StatScope( SweepStats* s ) : was(SweepStatsNow) { SweepStatsNow = s; }
+    ~StatScope() { SweepStatsNow = was; }
+};
+
+#define STAT_TIMER(name, field)  StatTimer name(&SweepStats::field)
+#define STAT_STOP(name)          name.Stop()
+
+#else
+
+#define STAT(field, k)           ((void)0)
+#define STAT_PEAK(field, v)      ((void)0)
+#define STAT_TIMER(name, field)  ((void)0)
+#define STAT_STOP(name)          ((void)0)
+
+#endif  /* SWEEP_STATS */
+
+#endif  /* SWEEPSTATS_H */
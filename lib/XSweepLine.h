@@ -0,0 +1,124 @@
+// XSweepLine.h - The all-crossings sweep line
+// all_Crossings() runs it over a whole segment set.
+
+#ifndef XSWEEPLINE_H
+#define XSWEEPLINE_H
+
+#include <vector>
+#include <atomic>
+#include "Avl.h"
+#include "EventQueue.h"
+
+// all-crossings SweepLine segment data
+class XSseg {
+public:
+    int      edge;         // segment Sg[edge] of the set
+    Point    lP;           // leftmost vertex point
+    Point    rP;           // rightmost vertex point
+    XSseg*   above;        // segment above this one
+    XSseg*   below;        // segment below this one
+    AvlNode<XSseg*, ItemComparable<XSseg*> >* node;    // its tree node, or 0
+
+    // a tree search for this segment is made at sweep point 'at', in the
+    // order the segments have just before it, or just after it if 'after'
+    const Point* at;
+    int      after;
+    int      rank;         // >= 0 while in a block being taken out
+
+    XSseg() : at(0), after(0), rank(-1) {}
+
+    // return true if P lies on this segment
+    bool contains( const Point* P ) const
+    {
+        return isLeft(lP, rP, *P) == 0
+            && xyorder(&lP, P) <= 0 && xyorder(P, &rP) <= 0;
+    }
+
+    // 'key' is below this segment if key->at is below it, or is on it
+    // and key runs below it on the side of 'at' being searched
+    cmp_t Compare(XSseg* key) const
+    {
+        if (key == this)
+            return EQ_CMP;
+        if (key->rank >= 0 && rank >= 0)     // both in the same block
+            return (key->rank < rank) ? MIN_CMP : MAX_CMP;
+
+        double d = isLeft(lP, rP, *key->at);
+        if (d == 0)
+            d = isLeft(lP, rP, key->after ? key->rP : key->lP);
+        if (d == 0)                          // collinear: order by edge
+            d = key->edge - edge;
+        return (d < 0) ? MIN_CMP : MAX_CMP;
+    }
+};
+
+typedef AvlNode<XSseg*, ItemComparable<XSseg*> > Xnode;
+
+// crossing event: the sweep line reaches the point where two adjacent
+// segments cross, and they must change places.  The queue's tree nodes
+// hold them by value.
+struct Xevent {
+    Point    P;            // crossing point
+    XSseg*   lo;           // segment below the other one before P
+    XSseg*   hi;           // segment above the other one before P
+    int      seq;          // orders crossings found at the same point
+};
+
+// the crossing event queue's comparator policy: in xy order of the
+// crossing points, then in the order they were found
+class XeventComparable {
+public:
+    static cmp_t Compare(const Xevent & item, const Xevent & key)
+    {
+        int r = xyorder(&key.P, &item.P);
+        if (r == 0)
+            r = (key.seq < item.seq) ? -1 : (key.seq > item.seq);
+        return cmp_t(r);
+    }
+};
+
+// the all-crossings Sweep Line
+class XSweepLine {
+    const Segment* Sg;     // the segment set
+    IgnorePair ignore;     // pairs of Sg[] ids not to report, if any
+    void*    arg;          // passed on to ignore
+    int      ns;           // number of segments swept
+    XSseg*   S;            // S[j] is the segment for event edge j
+    AvlTree<XSseg*, ItemComparable<XSseg*> >  Tree;   // tree of segments
+    AvlTree<Xevent, XeventComparable>  Xq;   // crossing events still to come
+    int      nx;           // number of crossing events queued so far
+    Point    at;           // current sweep point
+    vector<XSseg*>  B;     // segments in the tree that pass through 'at'
+    vector<XSseg*>  U;     // segments that start at 'at'
+    vector<Crossing>& X;   // crossings found
+public:
+    // for segments Sg[E[0..n-1]], or Sg[0..n-1] if E is 0
+    XSweepLine(const Segment* Sg, const int* E, int n,
+               IgnorePair ignore, void* arg, vector<Crossing> &Xout);
+    ~XSweepLine(void);
+
+    int      events( SweepContext &C ); // fill C.Edata, for an EventQueue
+
+    const Xevent* pending();            // next crossing event, if any
+    void     cross();                   // take the next crossing event
+    void     vertex( EventQueue &Eq );  // take all events at next vertex
+
+    // run the whole sweep; with 'first', stop once a crossing is found
+    // or *stop is set
+    void     sweep( EventQueue &Eq, bool first=false,
+                    const std::atomic<bool>* stop=0 );
+
+private:
+    XSseg*   locate( const Point* );
+    void     insert( XSseg* );
+    void     remove( XSseg* );
+    void     check( XSseg*, XSseg* );
+    void     report( XSseg*, XSseg*, const Point& );
+};
+// the edges of Pn as a segment set, S[i] being edge i with id i
+void P_segments( Polygon &Pn, vector<Segment> &S );
+
+// the IgnorePair that leaves out consecutive edges of polygon *arg
+bool P_consecutive( int e1, int e2, void* arg );
+
+#endif  /* XSWEEPLINE_H */
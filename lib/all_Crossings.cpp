@@ -0,0 +1,362 @@
+// all_Crossings.cpp - Find every pair of intersecting segments
+// A Bentley-Ottmann sweep (de Berg et al., "Computational Geometry",
+// ch. 2) built from the same EventQueue, AVL tree and predicates as
+// simple_Polygon().  Crossings found while sweeping are queued in
+// a second AVL tree, and when the sweep reaches one the two segments
+// swap places in the sweep line.  It works on any set of segments; a
+// polygon is swept as the set of its edges, consecutive ones left out
+// of the report.
+
+#include <algorithm>
+#include <atomic>
+#include "XSweepLine.h"
+
+XSweepLine::XSweepLine( const Segment* Sgs, const int* E, int n,
+                        IgnorePair ign, void* a, vector<Crossing> &Xout )
+    : X(Xout)
+{
+    Sg = Sgs;
+    ignore = ign;
+    arg = a;
+    ns = n;
+    nx = 0;
+    S = new XSseg[ns];
+    for (int j=0; j < ns; j++) {
+        int    i  = E ? E[j] : j;
+        bool   fwd = xyorder( &Sg[i].a, &Sg[i].b) < 0;
+        S[j].edge = i;
+        S[j].lP = fwd ? Sg[i].a : Sg[i].b;
+        S[j].rP = fwd ? Sg[i].b : Sg[i].a;
+        S[j].above = S[j].below = (XSseg*)0;
+        S[j].node = (Xnode*)0;
+    }
+}
+
+// the LEFT and RIGHT events of the segments, event edge j for S[j]
+//     Return: the number of events
+int XSweepLine::events( SweepContext &C )
+{
+    C.reserve(2 * ns);
+    Event* E = C.Edata;
+    for (int j=0; j < ns; j++) {
+        E[j].edge = E[ns+j].edge = j;
+        E[j].type = LEFT;
+        E[j].P = S[j].lP;
+        E[ns+j].type = RIGHT;
+        E[ns+j].P = S[j].rP;
+    }
+    return 2 * ns;
+}
+
+XSweepLine::~XSweepLine( void )
+{
+    delete[] S;
+}
+
+const Xevent* XSweepLine::pending()
+{
+    AvlNode<Xevent, XeventComparable>* nd = Xq.Search(Xevent(), MIN_CMP);
+    return nd ? &nd->Key() : (const Xevent*)0;
+}
+
+// return a segment in the tree that P lies on, or 0 if there is none
+XSseg* XSweepLine::locate( const Point* P )
+{
+    Xnode* nd = Tree.myRoot;
+    while (nd) {
+        XSseg* t = nd->Key();
+        double d = isLeft(t->lP, t->rP, *P);
+        if (d == 0 && t->contains(P))
+            return t;
+        nd = nd->Subtree((d < 0) ? Xnode::LEFT : Xnode::RIGHT);
+    }
+    return (XSseg*)0;
+}
+
+// add s to the tree in its order just after the sweep point
+void XSweepLine::insert( XSseg* s )
+{
+    s->at = &at;
+    s->after = 1;
+    s->rank = -1;
+
+    s->node = Tree.Insert(s);
+    Xnode* nx = Tree.Next(s->node);
+    Xnode* np = Tree.Prev(s->node);
+    XSseg* above = nx ? nx->Key() : (XSseg*)0;
+    XSseg* below = np ? np->Key() : (XSseg*)0;
+    s->above = above;
+    s->below = below;
+    if (above) above->below = s;
+    if (below) below->above = s;
+}
+
+// take s out of the tree, searching in the order just before the sweep point
+void XSweepLine::remove( XSseg* s )
+{
+    Xnode* nd = s->node;
+    s->at = &at;
+    s->after = 0;
+
+    // a node with two subtrees is kept and given its successor's data
+    bool moved = nd->Subtree(Xnode::LEFT) && nd->Subtree(Xnode::RIGHT);
+    if (Tree.Delete(s) && moved)
+        s->above->node = nd;
+
+    if (s->above) s->above->below = s->below;
+    if (s->below) s->below->above = s->above;
+    s->above = s->below = (XSseg*)0;
+    s->node = (Xnode*)0;
+}
+
+// queue a crossing event if lo, just below hi, crosses it further on
+void XSweepLine::check( XSseg* lo, XSseg* hi )
+{
+    if (lo == (XSseg*)0 || hi == (XSseg*)0)
+        return;
+
+    // lo must start below hi and end above it, and hi the reverse;
+    // anything else is no crossing, a touch, or a crossing already passed
+    double lsign = isLeft(hi->lP, hi->rP, lo->lP);
+    double rsign = isLeft(hi->lP, hi->rP, lo->rP);
+    if (lsign >= 0 || rsign <= 0)
+        return;
+    if (isLeft(lo->lP, lo->rP, hi->lP) <= 0 || isLeft(lo->lP, lo->rP, hi->rP) >= 0)
+        return;
+
+    Xevent x;
+    double t = lsign / (lsign - rsign);
+    x.P.x = lo->lP.x + t * (lo->rP.x - lo->lP.x);
+    x.P.y = lo->lP.y + t * (lo->rP.y - lo->lP.y);
+    // round-off must not put it past either right end, or behind the sweep
+    if (xyorder(&x.P, &lo->rP) > 0) x.P = lo->rP;
+    if (xyorder(&x.P, &hi->rP) > 0) x.P = hi->rP;
+    if (xyorder(&x.P, &at) < 0)     x.P = at;
+    x.lo = lo;
+    x.hi = hi;
+    x.seq = nx++;
+    Xq.Insert(x);
+}
+
+void XSweepLine::report( XSseg* s1, XSseg* s2, const Point& P )
+{
+    Crossing c;
+    c.e1 = (s1->edge < s2->edge) ? s1->edge : s2->edge;
+    c.e2 = (s1->edge < s2->edge) ? s2->edge : s1->edge;
+    c.P  = P;
+    if (ignore && ignore(Sg[c.e1].id, Sg[c.e2].id, arg))
+        return;      // such as consecutive edges, at their shared vertex
+    X.push_back(c);
+}
+
+void XSweepLine::cross()
+{
+    Xevent  x = Xq.Delete(Xevent(), MIN_CMP);
+    XSseg*  lo = x.lo;
+    XSseg*  hi = x.hi;
+    at = x.P;
+
+    // a stale event if the pair is no longer adjacent, or already crossed
+    if (lo->node == (Xnode*)0 || lo->above != hi)
+        return;
+
+    report(lo, hi, at);
+
+    // swap them in the tree, then relink:  b < lo < hi < a  =>  b < hi < lo < a
+    Xnode* nlo = lo->node;
+    Xnode* nhi = hi->node;
+    nlo->Data(hi);
+    nhi->Data(lo);
+    lo->node = nhi;
+    hi->node = nlo;
+
+    XSseg* b = lo->below;
+    XSseg* a = hi->above;
+    hi->below = b;
+    hi->above = lo;
+    lo->below = hi;
+    lo->above = a;
+    if (b) b->above = hi;
+    if (a) a->below = lo;
+
+    check(b, hi);
+    check(lo, a);
+}
+
+// Handle every vertex event at the next point on Eq together.  All the
+// segments through that point meet there, so all pairs of them are
+// reported; the ones passing through are taken out with the ones ending
+// there, and put back with the ones starting there in their new order.
+void XSweepLine::vertex( EventQueue &Eq )
+{
+    Event*  e = Eq.next();
+    XSseg*  seed = (XSseg*)0;  // a segment in the tree through 'at'
+
+    at = e->P;
+    U.clear();
+    B.clear();
+    for (;;) {
+        XSseg* s = &S[e->edge];
+        if (e->type == LEFT)
+            U.push_back(s);
+        else if (s->node && !seed)
+            seed = s;
+        if (!(e = Eq.peek()) || xyorder(&e->P, &at) != 0)
+            break;
+        Eq.next();
+    }
+    if (!seed)
+        seed = locate(&at);
+
+    // the segments through 'at' are a block of neighbours in the tree
+    if (seed) {
+        XSseg* s = seed;
+        while (s->below && s->below->contains(&at))
+            s = s->below;
+        for ( ; s && s->contains(&at); s = s->above)
+            B.push_back(s);
+    }
+
+    size_t nb = B.size();
+    size_t nu = U.size();
+    for (size_t i=0; i < nb; i++) {
+        for (size_t j=i+1; j < nb; j++)
+            report(B[i], B[j], at);
+        for (size_t j=0; j < nu; j++)
+            report(B[i], U[j], at);
+    }
+    for (size_t i=0; i < nu; i++)
+        for (size_t j=i+1; j < nu; j++)
+            report(U[i], U[j], at);
+
+    XSseg* b = nb ? B[0]->below : (XSseg*)0;
+    XSseg* a = nb ? B[nb-1]->above : (XSseg*)0;
+    for (size_t i=0; i < nb; i++)
+        B[i]->rank = (int)i;
+    for (size_t i=0; i < nb; i++)
+        remove(B[i]);
+    for (size_t i=0; i < nb; i++)
+        B[i]->rank = -1;
+
+    bool added = false;
+    for (size_t i=0; i < nb; i++) {
+        if (xyorder(&B[i]->rP, &at) > 0) {
+            insert(B[i]);
+            added = true;
+        }
+    }
+    for (size_t i=0; i < nu; i++) {
+        if (xyorder(&U[i]->rP, &at) > 0) {      // not a zero length edge
+            insert(U[i]);
+            added = true;
+        }
+    }
+
+    if (!added) {
+        check(b, a);
+        return;
+    }
+    for (size_t i=0; i < nb; i++) {
+        if (B[i]->node) {
+            check(B[i]->below, B[i]);
+            check(B[i], B[i]->above);
+        }
+    }
+    for (size_t i=0; i < nu; i++) {
+        if (U[i]->node) {
+            check(U[i]->below, U[i]);
+            check(U[i], U[i]->above);
+        }
+    }
+}
+
+// Vertex events come presorted from Eq, crossing events are queued as
+// they are found: take whichever is first, crossings first when they are
+// at the same point
+void XSweepLine::sweep( EventQueue &Eq, bool first,
+                        const std::atomic<bool>* stop )
+{
+    Event*      e;                 // the next vertex event
+    const Xevent* x;               // the next crossing event
+
+    for (;;) {
+        if (first && (!X.empty() || (stop && stop->load(std::memory_order_relaxed))))
+            break;
+        e = Eq.peek();
+        x = pending();
+        if (!e && !x)
+            break;
+        if (x && (!e || xyorder(&x->P, &e->P) <= 0))
+            cross();
+        else
+            vertex(Eq);
+    }
+}
+//===================================================================
+
+
+static bool X_less( const Crossing& c1, const Crossing& c2 )
+{
+    return (c1.e1 < c2.e1) || (c1.e1 == c2.e1 && c1.e2 < c2.e2);
+}
+
+static bool X_same( const Crossing& c1, const Crossing& c2 )
+{
+    return c1.e1 == c2.e1 && c1.e2 == c2.e2;
+}
+
+// the edges of Pn as a segment set, S[i] being edge i with id i
+void P_segments( Polygon &Pn, vector<Segment> &S )
+{
+    S.resize(Pn.n);
+    for (int i=0; i < Pn.n; i++) {
+        S[i].a = Pn.Vertex(i);
+        S[i].b = Pn.Vertex(Pn.Next(i));
+        S[i].id = i;
+    }
+}
+
+// consecutive edges of a ring of polygon *arg only meet at their shared
+// vertex, or overlap where the ring turns back on itself: the crossing
+// of the edges either side of that is reported
+bool P_consecutive( int e1, int e2, void* arg )
+{
+    Polygon* Pn = (Polygon*)arg;
+    return (Pn->Next(e1) == e2) || (e1 == Pn->Next(e2));
+}
+
+// all_Crossings(): find every pair of segments in a set that intersect
+//     Input:  S[ns] = the segments
+//             ignore = pairs not to report, if given
+//     Output: X  = one Crossing per intersecting pair, sorted by (e1, e2)
+//     Return: the number of crossings
+
+int all_Crossings( const Segment S[], int ns, vector<Crossing> &X,
+                   IgnorePair ignore, void* arg )
+{
+    X.clear();
+
+    SweepContext C;
+    XSweepLine  SL(S, (const int*)0, ns, ignore, arg, X);
+    EventQueue  Eq(C, SL.events(C));
+
+    SL.sweep(Eq);
+
+    // a pair that meets at more than one point was reported for each
+    stable_sort(X.begin(), X.end(), X_less);
+    X.erase(unique(X.begin(), X.end(), X_same), X.end());
+    return (int)X.size();
+}
+
+// all_Crossings(): find every pair of non-adjacent edges that intersect
+//     Input:  Pn = a polygon with n vertices V[]
+//     Output: X  = one Crossing per intersecting pair, sorted by (e1, e2)
+//     Return: the number of crossings (0 => Pn IS simple)
+
+int all_Crossings( Polygon &Pn, vector<Crossing> &X )
+{
+    vector<Segment> S;
+    P_segments(Pn, S);
+    return all_Crossings(S.data(), Pn.n, X, P_consecutive, &Pn);
+}
+//===================================================================
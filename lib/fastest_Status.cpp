@@ -0,0 +1,49 @@
+// fastest_Status.cpp - Time the status trees on a sample of the data
+// Which status tree is fastest depends on how wide the sweep line gets:
+// the binary trees do well on small polygons, the B+ tree when tens of
+// thousands of chains are in the sweep line at once.  Rather than guess,
+// sweep a sample with each kind and keep the fastest.
+
+#include <chrono>
+#include "simple_polygon.h"
+using namespace std;
+
+// fastest_Status(): time simple_Polygon() with each kind of status tree
+// on a sample of the data, to pick one for the rest of it
+//     Input:  P[np] = the sample polygons
+//     Output: ms[STATUS_KINDS], ms[k] = milliseconds kind k took, if given
+//     Return: the fastest kind
+
+StatusKind fastest_Status( Polygon* const P[], int np, double ms[] )
+{
+    const int    RUNS = 3;         // timed runs, the best one counting
+    SweepContext C;
+    StatusKind   best = STATUS_AVL;
+    double       tbest = 0;
+
+    for (int k=0; k < STATUS_KINDS; k++) {
+        C.status = (StatusKind)k;
+        for (int i=0; i < np; i++)          // warm up the context
+            simple_Polygon(*P[i], C);
+
+        double t = 0;
+        for (int r=0; r < RUNS; r++) {
+            std::chrono::steady_clock::time_point t0 =
+                std::chrono::steady_clock::now();
+            for (int i=0; i < np; i++)
+                simple_Polygon(*P[i], C);
+            double tr = std::chrono::duration<double, std::milli>(
+                std::chrono::steady_clock::now() - t0).count();
+            if (r == 0 || tr < t)
+                t = tr;
+        }
+        if (ms)
+            ms[k] = t;
+        if (k == 0 || t < tbest) {
+            best = (StatusKind)k;
+            tbest = t;
+        }
+    }
+    return best;
+}
+//===================================================================
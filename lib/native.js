@@ -0,0 +1,92 @@
+// The C++ sweep (node/addon.cpp) behind the same Polygon API as
+// lib/polygon.js, to swap in on the server:
+//
+//	var Polygon = require('sweepline2/lib/native').Polygon;
+//	new Polygon(points).isSimplePolygon();
+//
+// The addon is built by `npm run build:native` (node-gyp, into
+// build/Release) or by the CMake build (into build/); SWEEPLINE_NATIVE
+// names it if it is anywhere else.
+var path = require('path');
+
+var ASYNC_MIN = 1 << 14;	// vertices worth a trip to the thread pool
+
+function load() {
+	var tried = [];
+	var paths = process.env.SWEEPLINE_NATIVE ? [process.env.SWEEPLINE_NATIVE] : [
+		path.join(__dirname, '..', 'build', 'Release', 'sweepline.node'),
+		path.join(__dirname, '..', 'build', 'sweepline.node')
+	];
+	for (var i = 0; i < paths.length; i++) {
+		try {
+			return require(paths[i]);
+		} catch (e) {
+			tried.push(paths[i] + ': ' + e.message);
+		}
+	}
+	throw new Error('sweepline native addon not built; tried\n  ' + tried.join('\n  '));
+}
+
+var addon = load();
+
+// Packs an array of Points (or [x, y] pairs) into x,y pairs.
+function pack(point_array) {
+	var coords = new Float64Array(2 * point_array.length);
+	for (var i = 0; i < point_array.length; i++) {
+		var p = point_array[i];
+		coords[2 * i] = (p.x !== undefined) ? p.x : p[0];
+		coords[2 * i + 1] = (p.y !== undefined) ? p.y : p[1];
+	}
+	return coords;
+}
+
+// A polygon of an array of Points, as lib/polygon.js takes, or of a
+// Float64Array of x,y pairs, which is used as it is.  rings, if given, is
+// an Int32Array of where each ring starts, and then the vertex count.
+function Polygon(point_array, rings) {
+	if (point_array instanceof Float64Array) {
+		this.coords = point_array;
+		this.vertices = null;
+	} else {
+		this.coords = pack(point_array);
+		this.vertices = point_array;
+	}
+	this.rings = rings;
+}
+
+// Tests polygon simplicity.
+// returns true if simple, false if not.
+Polygon.prototype.isSimplePolygon = function () {
+	return addon.isSimple(this.coords, this.rings);
+};
+
+// As isSimplePolygon(), but a promise of the answer; a large polygon is
+// swept on the libuv thread pool, leaving the event loop free.  The
+// coordinates must not change until it settles.
+Polygon.prototype.isSimplePolygonAsync = function () {
+	if (this.coords.length < 2 * ASYNC_MIN) {
+		try {
+			return Promise.resolve(this.isSimplePolygon());
+		} catch (e) {
+			return Promise.reject(e);
+		}
+	}
+	return addon.isSimpleAsync(this.coords, this.rings);
+};
+
+// The pairs of edges that cross: { edges: Int32Array, points:
+// Float64Array }, crossing k being edges[2k], edges[2k+1] (edge i from
+// vertex i to the next) meeting at points[2k], points[2k+1].
+Polygon.prototype.crossings = function () {
+	return addon.crossings(this.coords, this.rings);
+};
+
+module.exports = {
+	Polygon: Polygon,
+
+	// A promise of a Uint8Array, 1 for each polygon that is simple: polygon
+	// i is vertices starts[i] to starts[i+1]-1 of coords, an Int32Array.
+	simplePolygons: addon.simplePolygons,
+
+	addon: addon
+};
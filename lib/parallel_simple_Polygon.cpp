@@ -0,0 +1,137 @@
+// parallel_simple_Polygon.cpp - Check one big polygon on several threads
+// The plane is cut at x = B[0] < B[1] < ... into closed vertical slabs,
+// about the same number of vertices in each, and every slab is swept on
+// its own thread by simple_Polygon()'s own sweep, over just the runs of
+// each chain's edges that meet it (slab_Simple()).  Two edges that meet
+// at x are both in the slab(s) holding x, so a meeting is never missed,
+// and a slab only ever reports edges that really meet.  A zero length
+// edge is found by every slab, as it is by simple_Polygon().  The threads
+// share a flag and all stop at the first meeting found.
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <exception>
+#include <system_error>
+#include <limits>
+#include "simple_polygon.h"
+using namespace std;
+
+// the shared state of one parallel_simple_Polygon() call
+class SlabSweep {
+    Polygon& P;
+    const double* B;       // slab s is B[s-1] <= x <= B[s]
+    int      nslab;
+    std::atomic<bool> found;   // two edges meeting were found by some slab
+    std::mutex   lock;     // guards err
+    std::exception_ptr err;    // first exception thrown by a worker
+public:
+    SlabSweep(Polygon& Pn, const double* Bs, int ns)
+        : P(Pn), B(Bs), nslab(ns), found(false) {}
+
+    void     work( int s );             // sweep slab s
+    bool     simple();                  // the result, once all are done
+};
+
+void SlabSweep::work( int s )
+{
+    try {
+        double x0 = (s > 0) ? B[s-1] : -numeric_limits<double>::max();
+        double x1 = (s < nslab-1) ? B[s] : numeric_limits<double>::max();
+        SweepContext C;
+        if (!slab_Simple(P, C, x0, x1, &found))
+            found.store(true);
+    } catch (...) {
+        std::lock_guard<std::mutex> g(lock);
+        if (!err)
+            err = std::current_exception();
+        found.store(true);                 // no point going on
+    }
+}
+
+bool SlabSweep::simple()
+{
+    if (err)
+        std::rethrow_exception(err);
+    return !found.load();
+}
+
+// parallel_simple_Polygon(): test if a big Polygon P is simple, sweeping
+// x-slabs of it on several threads
+//     Input:  Pn = a polygon with n vertices V[]
+//             nthreads = threads to use, 0 => one per core
+//     Return: FALSE(0) = is NOT simple
+//             TRUE(1)  = IS simple
+//     The result is exactly simple_Polygon(Pn), whatever nthreads is.
+
+bool parallel_simple_Polygon( Polygon &Pn, int nthreads )
+{
+    const int SLAB_MIN = 16384;    // fewest vertices worth a slab of its own
+    const int SAMPLE = 64;         // x samples taken per slab
+    const int SLAB_SHARE = 4;      // slabs must save 1/SLAB_SHARE of the edges
+
+    if (nthreads <= 0)
+        nthreads = (int)std::thread::hardware_concurrency();
+    if (nthreads <= 0)
+        nthreads = 1;
+    int nslab = nthreads;
+    if (nslab > Pn.n / SLAB_MIN)
+        nslab = Pn.n / SLAB_MIN;
+    if (nslab <= 1)                // a single slab: the plain sweep
+        return simple_Polygon(Pn);
+
+    // slab boundaries at quantiles of a sample of the vertex x's
+    int ns = SAMPLE * nslab;
+    vector<double> Xs(ns);
+    for (int j=0; j < ns; j++)
+        Xs[j] = Pn.Vertex((int)((long long)j * Pn.n / ns)).x;
+    sort(Xs.begin(), Xs.end());
+    vector<double> B;
+    for (int s=1; s < nslab; s++) {
+        double b = Xs[(long long)s * ns / nslab];
+        if (B.empty() || b > B.back())
+            B.push_back(b);
+    }
+    nslab = (int)B.size() + 1;
+
+    // the edges in each slab, edge i going in slabs first(lx)..last(rx):
+    // where most edges span most slabs (long edges across the whole
+    // polygon), every slab would sweep nearly all of them, and one sweep
+    // is as quick
+    vector<int> D(nslab + 1, 0);
+    for (int k=0; k < Pn.nr; k++) {
+        int a = Pn.RingStart(k), b = Pn.RingEnd(k);
+        for (int i=a; i < b; i++) {
+            double x1 = Pn.Vertex(i).x, x2 = Pn.Vertex((i+1 < b) ? i+1 : a).x;
+            double lx = (x1 < x2) ? x1 : x2;
+            double rx = (x1 < x2) ? x2 : x1;
+            D[lower_bound(B.begin(), B.end(), lx) - B.begin()]++;
+            D[upper_bound(B.begin(), B.end(), rx) - B.begin() + 1]--;
+        }
+    }
+    int most = 0;
+    for (int s=0, m=0; s < nslab; s++) {
+        m += D[s];
+        most = max(most, m);
+    }
+    if (most > Pn.n - Pn.n / SLAB_SHARE)
+        return simple_Polygon(Pn);
+
+    SlabSweep  W(Pn, B.data(), nslab);
+    vector<std::thread> T;
+    T.reserve(nslab);
+    try {
+        for (int s=1; s < nslab; s++)
+            T.push_back(std::thread(&SlabSweep::work, &W, s));
+    } catch (std::system_error &) {
+        // no more threads to be had: this one sweeps the slabs left over
+    }
+    W.work(0);
+    for (int s = (int)T.size() + 1; s < nslab; s++)
+        W.work(s);
+    for (size_t s=0; s < T.size(); s++)
+        T[s].join();
+    return W.simple();
+}
+//===================================================================
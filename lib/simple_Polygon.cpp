@@ -0,0 +1,765 @@
+//simple_Polygon.cpp - Check if a polygon is simple
+// Written by Dan Sunday (2001) (http://geomalgorithms.com/a09-_intersect-3.html)
+// Modified by Glenn Burkhardt (2014) to integrate it with the AVL balanced tree
+
+
+// Copyright 2001, softSurfer (www.softsurfer.com)
+// This code may be freely used and modified for any purpose
+// providing that this copyright notice is included with it.
+// SoftSurfer makes no warranty for this code, and cannot be held
+// liable for any real or imagined damage resulting from its use.
+// Users of this code must verify correctness for their application.
+
+// http://geomalgorithms.com/a09-_intersect-3.html#Simple-Polygons
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <math.h>
+#include <float.h>
+#include <algorithm>
+#include <atomic>
+#include <limits>
+#include "Avl.h"
+#include "Status.h"
+#include "simple_polygon.h"
+#include "EventQueue.h"
+#include "MeetKernel.h"
+#include "SweepStats.h"
+#include "Engines.h"
+
+
+
+// SweepLine Class
+// The sweep line holds monotone chains rather than single edges: a chain
+// is a run of consecutive edges that all go the same way in xy order, so
+// none of them can meet another but at their shared vertices.  A chain
+// goes into the tree at its left end and out at its right end; in between,
+// its current edge steps from one vertex to the next without touching the
+// tree, and only that edge is tested against its neighbours.
+
+// SweepLine chain data struct
+template <class T>
+class SLsegT {
+public:
+    int      edge;         // current edge; polygon edge i is V[i] to V[Next(i)]
+    int      step;         // +1 or -1, the way the chain runs through V[]
+    int      lo, hi;       // its ring is vertices lo to hi-1
+    bool     more;         // the chain goes on past rP
+    PointT<T> lP;          // leftmost vertex point of the current edge
+    PointT<T> rP;          // rightmost vertex point of the current edge
+    SLsegT*  above;        // chain above this one
+    SLsegT*  below;        // chain below this one
+    void*    node;         // the status tree's handle on it
+    bool     gone;         // being deleted: follow 'toward' to its node
+    cmp_t    toward;       // the side of this node the deleted one is on
+
+    SLsegT() : gone(false) {}
+    ~SLsegT() {}
+
+    // the edges after and before edge e around the chain's ring
+    int next( int e ) const { return (e+1 < hi) ? e+1 : lo; }
+    int prev( int e ) const { return (e > lo) ? e-1 : hi-1; }
+
+    // return true if P lies on the current edge
+    bool contains( const PointT<T>* P ) const
+    {
+        return isLeft(lP, rP, *P) == 0
+            && xyorder(&lP, P) <= 0 && xyorder(P, &rP) <= 0;
+    }
+
+    // 'key' is below this chain if its left point is below the current
+    // edge, or is on it and key's edge runs below it from there
+    cmp_t Compare(SLsegT* key) const
+    {
+        if (key == this)
+            return EQ_CMP;
+        if (key->gone)
+            return toward;
+
+        STAT(compares, 1);
+        double d = isLeft(lP, rP, key->lP);
+        if (d == 0)
+            d = isLeft(lP, rP, key->rP);
+        if (d == 0)                          // collinear: order by edge
+            d = key->edge - edge;
+        return (d < 0) ? MIN_CMP : MAX_CMP;
+    }
+};
+
+// the Sweep Line itself, keeping its chains in a Status tree (Status.h);
+// the chains left in it at the end go when the context is next reset
+template <class T, class Status>
+class SweepLineT {
+    typedef SLsegT<T> SLseg;
+
+    PolygonT<T>* Pn;       // initial Polygon
+    Pool*    segs;         // where SLsegs are allocated
+    SLseg**  Eseg;         // Eseg[i] is the chain whose current edge is i
+    SLseg**  Vq;           // heap of chains by the next vertex to step to
+    int      nq;           // number of chains in Vq
+    int      nlive;        // number of chains in Tree
+    T        xcut;         // chains stop at the first edge ending past it
+    Status   Tree;         // balanced search tree
+public:
+    SweepLineT(PolygonT<T> &P, SweepContextT<T> &C, T x1)   // constructor
+        : Tree(C.nodes, C.blocks)
+    {
+        Pn = &P; segs = &C.segs; Eseg = C.Eseg; Vq = C.Vq; nq = nlive = 0;
+        xcut = x1;
+    }
+
+    SLseg*   newSeg()
+    {
+        return new (segs->Alloc(sizeof(SLseg))) SLseg;
+    }
+
+    void     freeSeg( SLseg* s )
+    {
+        s->~SLseg();
+        segs->Free(s);
+    }
+
+    SLseg*   add( EventT<T>* );
+    SLseg*   find( EventT<T>* );
+    SLseg*   pending();                 // chain with the next inner vertex
+    SLseg*   advance();                 // step that chain to its next edge
+    bool     intersect( SLseg*, SLseg* );
+    bool     intersectAny( SLseg*, const PointT<T>* );
+    void     remove( SLseg* );
+
+private:
+    void     setEdge( SLseg*, int );
+    void     push( SLseg* );
+    void     pop();
+};
+
+// make edge e the current edge of chain s
+template <class T, class Status>
+void SweepLineT<T, Status>::setEdge( SLseg* s, int e )
+{
+    PointT<T> v1 = Pn->Vertex(e);
+    PointT<T> v2 = Pn->Vertex(s->next(e));
+    s->edge = e;
+    if (s->step > 0) {
+        s->lP = v1;
+        s->rP = v2;
+    }
+    else {
+        s->lP = v2;
+        s->rP = v1;
+    }
+    Eseg[e] = s;
+
+    // the next edge along belongs to the chain if it goes the same way;
+    // its near end is the vertex just read
+    int    n  = (s->step > 0) ? s->next(e) : s->prev(e);
+    PointT<T> w = Pn->Vertex((s->step > 0) ? s->next(n) : n);
+    if (s->step > 0)
+        s->more = xyorder( &v2, &w) < 0;
+    else
+        s->more = xyorder( &w, &v1) > 0;
+    if (s->rP.x > xcut)
+        s->more = false;   // the rest of it is past the slab
+    if (s->more)
+        push(s);
+}
+
+template <class T, class Status>
+SLsegT<T>* SweepLineT<T, Status>::add( EventT<T>* E )
+{
+    // if it is being added, then it must be the LEFT event of the chain's
+    // leftmost edge; which way the edge runs gives the chain's direction
+    SLseg* s = newSeg();
+    int    k = Pn->Ring(E->edge);
+    s->lo = Pn->RingStart(k);
+    s->hi = Pn->RingEnd(k);
+    PointT<T> v1 = Pn->Vertex(E->edge);
+    PointT<T> v2 = Pn->Vertex(s->next(E->edge));
+    s->step = (xyorder( &v1, &v2) < 0) ? 1 : -1;
+    setEdge(s, E->edge);
+
+    // add it to the status tree, between its neighbours
+    Tree.Insert(s, s->below, s->above);
+    nlive++;
+    STAT_PEAK(peak, nlive);
+    if (s->above != (SLseg*)0)
+        s->above->below = s;
+    if (s->below != (SLseg*)0)
+        s->below->above = s;
+    return s;
+}
+
+// the chain ending at the RIGHT event of E's edge
+template <class T, class Status>
+SLsegT<T>* SweepLineT<T, Status>::find( EventT<T>* E )
+{
+    return Eseg[E->edge];
+}
+
+template <class T, class Status>
+SLsegT<T>* SweepLineT<T, Status>::pending()
+{
+    return nq ? Vq[0] : (SLseg*)0;
+}
+
+template <class T, class Status>
+SLsegT<T>* SweepLineT<T, Status>::advance()
+{
+    SLseg* s = Vq[0];
+    STAT(advances, 1);
+    pop();
+    setEdge(s, (s->step > 0) ? s->next(s->edge) : s->prev(s->edge));
+    return s;
+}
+
+// Vq is a binary heap in xy order of the chains' right points
+template <class T, class Status>
+void SweepLineT<T, Status>::push( SLseg* s )
+{
+    int i = nq++;
+    while (i > 0) {
+        int p = (i - 1) / 2;
+        if (xyorder( &Vq[p]->rP, &s->rP) <= 0)
+            break;
+        Vq[i] = Vq[p];
+        i = p;
+    }
+    Vq[i] = s;
+}
+
+template <class T, class Status>
+void SweepLineT<T, Status>::pop()
+{
+    SLseg* s = Vq[--nq];
+    int i = 0;
+    for (;;) {
+        int c = 2*i + 1;
+        if (c >= nq)
+            break;
+        if (c+1 < nq && xyorder( &Vq[c+1]->rP, &Vq[c]->rP) < 0)
+            c++;
+        if (xyorder( &s->rP, &Vq[c]->rP) <= 0)
+            break;
+        Vq[i] = Vq[c];
+        i = c;
+    }
+    Vq[i] = s;
+}
+
+template <class T, class Status>
+void SweepLineT<T, Status>::remove( SLseg* s )
+{
+    // where s is has nothing to do with its geometry by now, so the
+    // status tree takes it out by its handle
+    Tree.Remove(s);
+    nlive--;
+
+    // get the above and below chains pointing to each other
+    // (they are the tree neighbours s was linked to)
+    if (s->above != (SLseg*)0)
+        s->above->below = s->below;
+    if (s->below != (SLseg*)0)
+        s->below->above = s->above;
+    freeSeg(s);
+}
+
+// test intersect of the current edges of 2 chains: 0=none, 1=intersect
+template <class T, class Status>
+bool SweepLineT<T, Status>::intersect( SLseg* s1, SLseg* s2)
+{
+    if (s1 == (SLseg*)0 || s2 == (SLseg*)0)
+        return false;      // no intersect if either segment doesn't exist
+
+    // check for consecutive edges in polygon (of one ring)
+    int e1 = s1->edge;
+    int e2 = s2->edge;
+    if ((s1->next(e1) == e2) || (e1 == s2->next(e2)))
+        return false;      // no non-simple intersect since consecutive
+
+    return E_meet(s1->lP, s1->rP, s2->lP, s2->rP);
+}
+
+// test the current edge of s against the chains next to it, at its end
+// point P.  Those that pass through P too are all around it in any order,
+// and one may be a consecutive edge hiding another one: look past them.
+template <class T, class Status>
+bool SweepLineT<T, Status>::intersectAny( SLseg* s, const PointT<T>* P )
+{
+    SLseg* t;
+    for (t = s->above; ; t = t->above) {
+        if (intersect( s, t))
+            return true;
+        if (t == (SLseg*)0 || !t->contains(P))
+            break;
+    }
+    for (t = s->below; ; t = t->below) {
+        if (intersect( s, t))
+            return true;
+        if (t == (SLseg*)0 || !t->contains(P))
+            break;
+    }
+    return false;
+}
+//===================================================================
+
+
+// SweepContext Routines
+
+thread_local Pool* AvlArena = NULL;
+
+template <class T>
+SweepContextT<T>::SweepContextT()
+    : status(STATUS_AVL),
+      engine(ENGINE_SWEEP),
+      nodes((size_t)StatusAvl<SLsegT<T> >::NODE_SIZE
+            > (size_t)StatusRB<SLsegT<T> >::NODE_SIZE
+            ? (size_t)StatusAvl<SLsegT<T> >::NODE_SIZE
+            : (size_t)StatusRB<SLsegT<T> >::NODE_SIZE),
+      blocks(StatusBtree<SLsegT<T> >::NODE_SIZE, 8),
+      segs(sizeof(SLsegT<T>))
+{
+    Edata = Etmp = (EventT<T>*)0;
+    Eseg = Vq = (SLsegT<T>**)0;
+    room = 0;
+    work = (EngineWorkT<T>*)0;
+    stats = (SweepStats*)0;
+}
+
+template <class T>
+SweepContextT<T>::~SweepContextT()
+{
+    delete[] Vq;
+    delete[] Eseg;
+    delete[] Etmp;
+    delete[] Edata;
+    delete work;
+}
+
+template <class T>
+void SweepContextT<T>::reserve( int ne )
+{
+    if (ne <= room)
+        return;
+    delete[] Vq;
+    delete[] Eseg;
+    delete[] Etmp;
+    delete[] Edata;
+    Edata = Etmp = (EventT<T>*)0;
+    Eseg = Vq = (SLsegT<T>**)0;
+    room = 0;
+    Edata = new EventT<T>[ne];
+    Etmp = new EventT<T>[ne];
+    Eseg = new SLsegT<T>*[ne];
+    Vq = new SLsegT<T>*[ne];
+    room = ne;
+}
+
+template <class T>
+void SweepContextT<T>::reset()
+{
+    nodes.Reset();
+    blocks.Reset();
+    segs.Reset();
+}
+//===================================================================
+
+
+// Fast paths
+// Most polygons met in practice are small or convex, and need no sweep:
+// a triangle or a quad is checked in closed form, and a single ring in
+// one pass that proves it convex, if it is, before any events are made.
+// Any other polygon of a few dozen vertices has its edges tested pair by
+// pair, a block of pairs at a time, in less time than sorting its events.
+
+// E_apart(): test if the edges p0-p1 and q0-q1 (in either order) are
+// apart: 0=they meet, 1=apart
+template <class T>
+static inline bool E_apart( PointT<T> p0, PointT<T> p1,
+                            PointT<T> q0, PointT<T> q1 )
+{
+    if (xyorder(&p0, &p1) > 0) std::swap(p0, p1);
+    if (xyorder(&q0, &q1) > 0) std::swap(q0, q1);
+    return !E_meet(p0, p1, q0, q1);
+}
+
+// P_convex(): go once round Pn, a single ring of n >= 5 vertices, for
+// the turn at each vertex and the way each edge goes in xy order.  A ring
+// that turns the same way at every vertex, and changes from going right
+// to going left only at its rightmost vertex and back at its leftmost,
+// is strictly convex: each of its two chains bulges away from the other.
+//     Return: 0 = Pn has a zero length edge (is NOT simple)
+//             1 = Pn is strictly convex (IS simple)
+//            -1 = neither, as far as the pass got: it must be swept
+template <class T>
+static int P_convex( PolygonT<T> &Pn )
+{
+    int       n = Pn.n;
+    PointT<T> v0 = Pn.Vertex(n-2);
+    PointT<T> v1 = Pn.Vertex(n-1);
+    PointT<T> v2 = Pn.Vertex(0);
+    int       dir = xyorder(&v1, &v2);     // the closing edge first
+    if (dir == 0 || xyorder(&v0, &v1) == 0)
+        return 0;
+    double    turn = isLeft(v0, v1, v2);
+    int       changes = 0;                 // changes of direction
+
+    for (int i=0; i < n; i++) {            // the turn at vertex i
+        v0 = v1;
+        v1 = v2;
+        v2 = Pn.Vertex((i+1 < n) ? i+1 : 0);
+        int r = xyorder(&v1, &v2);
+        if (r == 0)
+            return 0;
+        double t = isLeft(v0, v1, v2);
+        if (t == 0 || (t > 0) != (turn > 0))
+            return -1;
+        if (r != dir && ++changes > 2)
+            return -1;
+        dir = r;
+    }
+    return (changes == 2) ? 1 : -1;
+}
+
+// KernelCoord: if coordinates of type T are doubles, or go into them
+// exactly, so that the MeetKernel's error bound holds for them
+template <class T> struct KernelCoord       { enum { exact = 0 }; };
+template <> struct KernelCoord<double>      { enum { exact = 1 }; };
+template <> struct KernelCoord<float>       { enum { exact = 1 }; };
+template <> struct KernelCoord<int32_t>     { enum { exact = 1 }; };
+
+#define BRUTE_MAX 48       // below this many vertices, P_brute() beats a sweep
+#define BRUTE_BLOCK 4      // fewer edges than this are tested one by one
+
+// P_brute(): test every pair of edges of Pn, n < BRUTE_MAX, that are
+// not consecutive around a ring and whose x ranges overlap.  In order of
+// their left ends, each edge is tested against the block of later ones
+// starting before it ends, all at once with the MeetKernel (MeetKernel.h),
+// and with E_meet() for the pairs the kernel leaves unsure.
+//     Return: 0 = Pn is NOT simple
+//             1 = Pn IS simple
+template <class T>
+static int P_brute( PolygonT<T> &Pn )
+{
+    static const MeetKernel K = meet_Kernel(best_Isa());
+    int       n = Pn.n;
+    PointT<T> L[BRUTE_MAX], R[BRUTE_MAX];      // edge i is L[i] to R[i]
+    int       next[BRUTE_MAX], prev[BRUTE_MAX];
+    int       id[BRUTE_MAX];       // the edges in x order of left ends
+    int       at[BRUTE_MAX];       // where each edge is in that order
+    double    lx[BRUTE_MAX + KERNEL_PAD], ly[BRUTE_MAX + KERNEL_PAD];
+    double    rx[BRUTE_MAX + KERNEL_PAD], ry[BRUTE_MAX + KERNEL_PAD];
+
+    for (int k=0; k < Pn.nr; k++) {
+        int a = Pn.RingStart(k);
+        int b = Pn.RingEnd(k);
+        for (int i=a; i < b; i++) {
+            next[i] = (i+1 < b) ? i+1 : a;
+            prev[i] = (i > a) ? i-1 : b-1;
+            PointT<T> p = Pn.Vertex(i);
+            PointT<T> q = Pn.Vertex(next[i]);
+            int r = xyorder(&p, &q);
+            if (r == 0)
+                return 0;  // the edges either side of it meet
+            L[i] = (r < 0) ? p : q;
+            R[i] = (r < 0) ? q : p;
+        }
+    }
+    for (int i=0; i < n; i++) {
+        int j = i;
+        for ( ; j > 0 && L[id[j-1]].x > L[i].x; j--)
+            id[j] = id[j-1];
+        id[j] = i;
+    }
+    for (int k=0; k < n + KERNEL_PAD; k++) {
+        int i = (k < n) ? id[k] : 0;
+        if (k < n)
+            at[i] = k;
+        lx[k] = (double)L[i].x;
+        ly[k] = (double)L[i].y;
+        rx[k] = (double)R[i].x;
+        ry[k] = (double)R[i].y;
+    }
+
+    for (int k=0; k+1 < n; k++) {
+        int m = 0;                 // edges k+1 .. k+m start before k ends
+        while (k+1+m < n && lx[k+1+m] <= rx[k])
+            m++;
+        int      i = id[k];
+        int      a = at[next[i]] - (k+1);
+        int      b = at[prev[i]] - (k+1);
+        uint64_t skip = 0;         // bit j-k-1 for the edge j-th in order
+        if (a >= 0 && a < m) skip |= (uint64_t)1 << a;
+        if (b >= 0 && b < m) skip |= (uint64_t)1 << b;
+
+        uint64_t hit = 0, unsure;
+        if (m < BRUTE_BLOCK)       // not worth a kernel call
+            unsure = ((uint64_t)1 << m) - 1;
+        else {
+            double q[4] = { lx[k], ly[k], rx[k], ry[k] };
+            K(q, lx+k+1, ly+k+1, rx+k+1, ry+k+1, m, &hit, &unsure);
+        }
+        if (hit & ~skip)
+            return 0;
+        unsure &= ~skip;
+        for (int j=k+1; unsure; j++, unsure >>= 1)
+            if ((unsure & 1) && E_meet(L[i], R[i], L[id[j]], R[id[j]]))
+                return 0;
+    }
+    return 1;
+}
+
+// P_quick(): simple_Polygon() for Pn if it needs no sweep
+//     Return: 0 = Pn is NOT simple
+//             1 = Pn IS simple
+//            -1 = Pn must be swept
+template <class T>
+static int P_quick( PolygonT<T> &Pn )
+{
+    if (Pn.n < 3)
+        return 1;          // every pair of edges is consecutive
+    if (Pn.nr > 1)
+        return (KernelCoord<T>::exact && Pn.n < BRUTE_MAX) ? P_brute(Pn) : -1;
+
+    if (Pn.n <= 4) {
+        PointT<T> V[4];
+        for (int i=0; i < Pn.n; i++)
+            V[i] = Pn.Vertex(i);
+        for (int i=0; i < Pn.n; i++)
+            if (xyorder(&V[i], &V[(i+1) % Pn.n]) == 0)
+                return 0;  // the edges either side of it meet
+        if (Pn.n == 3)
+            return 1;      // every pair of edges is consecutive
+        return E_apart(V[0], V[1], V[2], V[3])
+            && E_apart(V[1], V[2], V[3], V[0]);
+    }
+    int c = P_convex(Pn);
+    if (c < 0 && KernelCoord<T>::exact && Pn.n < BRUTE_MAX)
+        return P_brute(Pn);
+    return c;
+}
+//===================================================================
+
+
+// simple_Polygon(): test if a Polygon P is simple or not
+//     Input:  Pn = a polygon with n vertices V[]
+//     Return: FALSE(0) = is NOT simple
+//             TRUE(1)  = IS simple
+
+template <class T>
+bool simple_Polygon( PolygonT<T> &Pn )
+{
+    SweepContextT<T> C;
+    return simple_Polygon(Pn, C);
+}
+
+// C_events(): fill C.Edata with the LEFT and RIGHT events of the
+// monotone chains of Pn's rings, each one carrying its end edge of the
+// chain.  Given a slab x0 <= x <= x1, just the runs of each chain's edges
+// that meet it, which start at an edge beginning left of x0 or end at
+// one ending right of x1.
+//     Return: the number of events, or -1 if Pn has a zero length edge
+template <class T>
+static int C_events( PolygonT<T> &Pn, SweepContextT<T> &C,
+                     T x0 = std::numeric_limits<T>::lowest(),
+                     T x1 = std::numeric_limits<T>::max() )
+{
+    EventT<T>* E = C.Edata;
+    int        ne = 0;
+
+    for (int k=0; k < Pn.nr; k++) {
+        int a = Pn.RingStart(k);            // ring k is a .. a+n-1
+        int n = Pn.RingEnd(k) - a;
+
+        // fwd[i] (edge i runs left to right) for edges i-1, i and i+1,
+        // edge i being v0 to v1
+        PointT<T> v0 = Pn.Vertex(a);
+        PointT<T> v1 = Pn.Vertex(a + (1 % n));
+        PointT<T> vn = Pn.Vertex(a + n-1);
+        int    r = xyorder( &vn, &v0 );
+        bool   prev = r < 0;
+        r = xyorder( &v0, &v1 );
+        if (r == 0)
+            return -1;
+        bool   cur = r < 0;
+        for (int i=0; i < n; i++) {
+            PointT<T> v2 = Pn.Vertex(a + (i+2) % n);
+            if ((r = xyorder( &v1, &v2 )) == 0)
+                return -1;
+            bool next = r < 0;
+
+            // edge i ends a chain on a side where its neighbour turns back,
+            // or where the slab does
+            T    lx = cur ? v0.x : v1.x;
+            T    rx = cur ? v1.x : v0.x;
+            bool in = lx <= x1 && rx >= x0;
+            bool lend = in && ((cur ? !prev : next) || lx < x0);
+            bool rend = in && ((cur ? !next : prev) || rx > x1);
+            if (lend) {
+                E[ne].P = cur ? v0 : v1;
+                E[ne].edge = a + i;
+                E[ne++].type = LEFT;
+            }
+            if (rend) {
+                E[ne].P = cur ? v1 : v0;
+                E[ne].edge = a + i;
+                E[ne++].type = RIGHT;
+            }
+            prev = cur;
+            cur = next;
+            v0 = v1;
+            v1 = v2;
+        }
+    }
+    return ne;
+}
+
+// C_sweep(): sweep the ne events C_events() made, with the chains in a
+// Status tree, their edges ending past x1 being the last (as C_events()
+// was given), and giving up once *stop is set, if given
+//     Return: FALSE(0) = Pn is NOT simple
+//             TRUE(1)  = Pn IS simple, or the sweep was stopped
+template <class T, class Status>
+static bool C_sweep( PolygonT<T> &Pn, SweepContextT<T> &C, int ne,
+                     T x1 = std::numeric_limits<T>::max(),
+                     const std::atomic<bool>* stop = (const std::atomic<bool>*)0 )
+{
+    ArenaScope     A(C.nodes);     // tree nodes come from C too
+    STAT_TIMER(tsort, sort_ms);
+    EventQueueT<T> Eq(C, ne);      // sorts the events
+    STAT_STOP(tsort);
+    STAT_TIMER(tsweep, sweep_ms);
+    SweepLineT<T, Status> SL(Pn, C, x1);
+    unsigned       nstep = 0;
+    EventT<T>*     e;              // the next chain end event
+    SLsegT<T>*     s;              // the current SL chain
+
+    // This loop processes the chain ends in the sorted queue, and in
+    // between steps chains on from one edge to the next in xy order.
+    // No new events will be added (an intersect => Done)
+    for (;;) {
+        e = Eq.peek();
+        s = SL.pending();
+        if (!e && !s)
+            break;
+        if (stop && (++nstep & 1023) == 0 && stop->load(std::memory_order_relaxed))
+            break;
+        if (s && (!e || xyorder(&s->rP, &e->P) <= 0)) {
+            s = SL.advance();      // step to the chain's next edge
+            if (SL.intersectAny( s, &s->lP))
+                return false;      // Pn is NOT simple
+            continue;
+        }
+        e = Eq.next();
+        STAT(events, 1);
+        if (e->type == LEFT) {     // process a left vertex
+            s = SL.add(e);         // add it to the sweep line
+            if (SL.intersectAny( s, &s->lP))
+                return false;      // Pn is NOT simple
+        }
+        else {                     // process a right vertex
+            s = SL.find(e);
+            if (SL.intersectAny( s, &s->rP))
+                return false;      // Pn is NOT simple
+            if (SL.intersect( s->above, s->below))
+                return false;      // Pn is NOT simple
+            SL.remove(s);          // remove it from the sweep line
+        }
+    }
+    return true;      // Pn is simple
+}
+
+// P_simple(): simple_Polygon(Pn, C), but for keeping its counts
+template <class T>
+static bool P_simple( PolygonT<T> &Pn, SweepContextT<T> &C )
+{
+    int q = P_quick(Pn);
+    if (q >= 0) {
+        STAT(quick, 1);
+        return q != 0;
+    }
+
+    EngineKind e = (C.engine == ENGINE_AUTO) ? choose_Engine(Pn) : C.engine;
+    if (e != ENGINE_SWEEP) {
+        if (!C.work)
+            C.work = new EngineWorkT<T>;
+        int r = (e == ENGINE_GRID)  ? grid_Simple(Pn, *C.work)
+              : (e == ENGINE_RTREE) ? rtree_Simple(Pn, *C.work)
+              :                       brute_Simple(Pn, *C.work);
+        if (r >= 0)
+            return r != 0;
+    }
+
+    C.reset();
+    C.reserve(2 * Pn.n);           // 2 events per chain, at most
+    int ne = C_events(Pn, C);
+    if (ne < 0)
+        return false;     // the edges either side of it meet
+
+    switch (C.status) {
+    case STATUS_RB:
+        return C_sweep<T, StatusRB<SLsegT<T> > >(Pn, C, ne);
+    case STATUS_BTREE:
+        return C_sweep<T, StatusBtree<SLsegT<T> > >(Pn, C, ne);
+    default:
+        return C_sweep<T, StatusAvl<SLsegT<T> > >(Pn, C, ne);
+    }
+}
+
+template <class T>
+bool simple_Polygon( PolygonT<T> &Pn, SweepContextT<T> &C )
+{
+#ifdef SWEEP_STATS
+    StatScope S(C.stats);          // count into C.stats, if it is set
+    if (C.stats) {
+        *C.stats = SweepStats();
+        C.stats->calls = 1;
+        C.stats->vertices = Pn.n;
+    }
+    STAT_TIMER(ttotal, total_ms);
+#endif
+    return P_simple(Pn, C);
+}
+
+// slab_Simple(): simple_Polygon()'s sweep over just the edges of Pn that
+// meet the slab x0 <= x <= x1, for parallel_simple_Polygon()
+//     Input:  stop = set when another slab has found two edges meeting
+//     Return: FALSE(0) = two edges meet, so Pn is NOT simple
+//             TRUE(1)  = none meet in the slab, or the sweep was stopped
+
+bool slab_Simple( Polygon &Pn, SweepContext &C, double x0, double x1,
+                  const std::atomic<bool>* stop )
+{
+    C.reset();
+    C.reserve(2 * Pn.n);
+    int ne = C_events(Pn, C, x0, x1);
+    if (ne < 0)
+        return false;     // the edges either side of it meet
+
+    switch (C.status) {
+    case STATUS_RB:
+        return C_sweep<double, StatusRB<SLsegT<double> > >(Pn, C, ne, x1, stop);
+    case STATUS_BTREE:
+        return C_sweep<double, StatusBtree<SLsegT<double> > >(Pn, C, ne, x1, stop);
+    default:
+        return C_sweep<double, StatusAvl<SLsegT<double> > >(Pn, C, ne, x1, stop);
+    }
+}
+
+// the coordinate types simple_Polygon() is built for
+template class SweepContextT<double>;
+template bool simple_Polygon( PolygonT<double> & );
+template bool simple_Polygon( PolygonT<double> &, SweepContextT<double> & );
+template class SweepContextT<float>;
+template bool simple_Polygon( PolygonT<float> & );
+template bool simple_Polygon( PolygonT<float> &, SweepContextT<float> & );
+#ifdef __SIZEOF_INT128__
+template class SweepContextT<int32_t>;
+template bool simple_Polygon( PolygonT<int32_t> & );
+template bool simple_Polygon( PolygonT<int32_t> &, SweepContextT<int32_t> & );
+template class SweepContextT<int64_t>;
+template bool simple_Polygon( PolygonT<int64_t> & );
+template bool simple_Polygon( PolygonT<int64_t> &, SweepContextT<int64_t> & );
+#endif  /* __SIZEOF_INT128__ */
+//===================================================================
@@ -0,0 +1,192 @@
+// simple_Polygons.cpp - Check a batch of polygons on several threads
+// The polygons are cut into tasks of about the same number of vertices,
+// the biggest polygons first, and dealt out to one task queue per thread.
+// A thread works from the front of its own queue and, once that is empty,
+// steals from the back of the others.  Each thread sweeps in its own
+// SweepContext, so it stops allocating once warmed up.
+
+#include <thread>
+#include <mutex>
+#include <deque>
+#include <exception>
+#include <system_error>
+#include "simple_polygon.h"
+#include "SweepStats.h"
+using namespace std;
+
+// a task: check polygons P[Ix[first]] .. P[Ix[last-1]]
+typedef struct {
+    int      first, last;
+} PolyTask;
+
+// the per-thread task queues
+class TaskQueues {
+    struct Queue {
+        std::mutex  lock;
+        std::deque<PolyTask> tasks;
+    };
+    int      nq;           // number of queues
+    Queue*   Q;
+public:
+    TaskQueues(int n) { nq = n; Q = new Queue[n]; }
+    ~TaskQueues(void) { delete[] Q; }
+
+    void     push( int q, const PolyTask &t );
+    bool     pop( int q, PolyTask &t );  // own task, else a stolen one
+};
+
+void TaskQueues::push( int q, const PolyTask &t )
+{
+    std::lock_guard<std::mutex> g(Q[q].lock);
+    Q[q].tasks.push_back(t);
+}
+
+bool TaskQueues::pop( int q, PolyTask &t )
+{
+    {
+        std::lock_guard<std::mutex> g(Q[q].lock);
+        if (!Q[q].tasks.empty()) {
+            t = Q[q].tasks.front();
+            Q[q].tasks.pop_front();
+            return true;
+        }
+    }
+    // steal the smallest task left in another queue
+    for (int i=1; i < nq; i++) {
+        Queue& v = Q[(q + i) % nq];
+        std::lock_guard<std::mutex> g(v.lock);
+        if (!v.tasks.empty()) {
+            t = v.tasks.back();
+            v.tasks.pop_back();
+            return true;
+        }
+    }
+    return false;
+}
+
+// the shared state of one simple_Polygons() call
+class PolyBatch {
+    Polygon* const* P;     // the polygons
+    bool*    S;            // their results
+    const int* Ix;         // the order to check them in
+    TaskQueues*  Tq;
+    StatusKind   status;   // the status tree to sweep with
+    EngineKind   engine;   // the engine to use
+    SweepStats*  stats;    // their counts, or 0
+    std::mutex   lock;     // guards err
+    std::exception_ptr err;    // first exception thrown by a worker
+public:
+    PolyBatch(Polygon* const* Pp, bool* Sp, const int* I, TaskQueues* T,
+              StatusKind k, EngineKind e, SweepStats* st)
+        : P(Pp), S(Sp), Ix(I), Tq(T), status(k), engine(e), stats(st) {}
+
+    void     work( int q );             // a worker thread's main loop
+    void     rethrow();                 // pass on a worker's exception
+};
+
+void PolyBatch::work( int q )
+{
+    try {
+        SweepContext C;
+        PolyTask     t;
+        C.status = status;
+        C.engine = engine;
+        while (Tq->pop(q, t))
+            for (int i = t.first; i < t.last; i++) {
+                if (stats)
+                    C.stats = &stats[Ix[i]];
+                S[Ix[i]] = simple_Polygon(*P[Ix[i]], C);
+            }
+    } catch (...) {
+        std::lock_guard<std::mutex> g(lock);
+        if (!err)
+            err = std::current_exception();
+    }
+}
+
+void PolyBatch::rethrow()
+{
+    if (err)
+        std::rethrow_exception(err);
+}
+
+// simple_Polygons(): test a batch of polygons, spread over several threads
+//     Input:  P[np] = the polygons
+//             nthreads = threads to use, 0 => one per core
+//             status = the status tree to sweep with
+//             engine = the engine to use (Engines.h)
+//     Output: S[np], S[i] = simple_Polygon(*P[i])
+//             stats[np], stats[i] = the counts of that call, if given
+
+void simple_Polygons( Polygon* const P[], int np, bool S[], int nthreads,
+                      StatusKind status, SweepStats stats[],
+                      EngineKind engine )
+{
+    if (nthreads <= 0)
+        nthreads = (int)std::thread::hardware_concurrency();
+    if (nthreads <= 0)
+        nthreads = 1;
+
+    // order the polygons biggest first, by power of two of their size
+    // (a counting sort: a full sort would cost more than it gains)
+    const int NCLASS = 32;
+    int       start[NCLASS + 1] = { 0 };
+    long long total = 0;
+    for (int i=0; i < np; i++) {
+        int n = P[i]->n, c = 0;
+        while (c < NCLASS - 1 && (n >> (c + 1)))
+            c++;
+        start[NCLASS - 1 - c + 1]++;
+        total += n;
+    }
+    for (int c=0; c < NCLASS; c++)
+        start[c+1] += start[c];
+    vector<int> Ix(np);
+    for (int i=0; i < np; i++) {
+        int n = P[i]->n, c = 0;
+        while (c < NCLASS - 1 && (n >> (c + 1)))
+            c++;
+        Ix[start[NCLASS - 1 - c]++] = i;
+    }
+
+    // cut them into tasks of at least 'grain' vertices, aiming for
+    // several tasks per thread so the last ones can be balanced out
+    long long grain = total / (8LL * nthreads);
+    if (grain < 4096)
+        grain = 4096;
+
+    TaskQueues Tq(nthreads);
+    int        ntasks = 0;
+    for (int i=0; i < np; ) {
+        PolyTask  t;
+        long long nv = 0;
+        t.first = i;
+        while (i < np && nv < grain)
+            nv += P[Ix[i++]]->n;
+        t.last = i;
+        Tq.push(ntasks++ % nthreads, t);
+    }
+    if (nthreads > ntasks)
+        nthreads = ntasks;
+
+    PolyBatch  B(P, S, Ix.empty() ? (int*)0 : &Ix[0], &Tq, status,
+               engine, stats);
+    if (nthreads <= 1) {
+        B.work(0);
+    } else {
+        vector<std::thread> T;
+        T.reserve(nthreads);
+        try {
+            for (int q=1; q < nthreads; q++)
+                T.push_back(std::thread(&PolyBatch::work, &B, q));
+        } catch (std::system_error &) {
+            // no more threads to be had: the ones running steal the tasks
+            // of the queues no thread was started for
+        }
+        B.work(0);
+        for (size_t q=0; q < T.size(); q++)
+            T[q].join();
+    }
+    B.rethrow();
+}
+//===================================================================
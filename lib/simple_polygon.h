@@ -0,0 +1,330 @@
+// simple_polygon.h - Class for a polygon
+// Written by Glenn Burkhardt (2014)
+/*
+ * simple_polygon.h
+ *
+ */
+
+#ifndef SIMPLE_POLYGON_H_
+#define SIMPLE_POLYGON_H_
+
+#include <stdio.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <vector>
+#include <string>
+#include <atomic>
+#include "Pool.h"
+
+// Points and polygons come in the coordinate type T of the data: double,
+// float, or int32_t / int64_t fixed point, which simple_Polygon() works
+// on exactly (int64_t coordinates must be within +-2^62).  Point and
+// Polygon are the double ones, which the batch, parallel and all-crossings
+// sweeps below take.
+template <class T>
+struct PointT {
+    T x, y;
+};
+
+typedef PointT<double> Point;
+
+template <class T>
+struct PolygonT {
+    PolygonT(int npts) {
+        n = npts;
+        V = (PointT<T>*)malloc(npts * sizeof(PointT<T>));
+        xs = V ? (const char*)V + offsetof(PointT<T>, x) : (const char*)0;
+        ys = V ? (const char*)V + offsetof(PointT<T>, y) : (const char*)0;
+        stride = sizeof(PointT<T>);
+        nr = 1;
+        R = (const int*)0;
+    }
+
+    // a view of npts vertices in the caller's memory, vertex i being
+    // x[i], y[i] taken 'stride' bytes apart: (x, x+1, 2*sizeof(T)) for
+    // x,y pairs, or separate x[] and y[] arrays.  Nothing is copied, and
+    // the caller's buffer must outlive the view.  V is then NULL.
+    PolygonT(const T* x, const T* y, int npts, size_t step=sizeof(T)) {
+        n = npts;
+        V = (PointT<T>*)0;
+        xs = (const char*)x;
+        ys = (const char*)y;
+        stride = step;
+        nr = 1;
+        R = (const int*)0;
+    }
+
+    ~PolygonT() {
+        free(V);
+    }
+
+    // vertex i, from wherever the coordinates are (they need not be
+    // aligned, as in WKB)
+    PointT<T> Vertex(int i) const {
+        PointT<T> p;
+        memcpy(&p.x, xs + i * stride, sizeof(T));
+        memcpy(&p.y, ys + i * stride, sizeof(T));
+        return p;
+    }
+
+    // make the polygon nrings closed rings, ring k being vertices
+    // start[k] to start[k+1]-1 (start[0] = 0, start[nrings] = n): a shell
+    // and its holes, or all the rings of a multipolygon.  start[] is the
+    // caller's, and must outlive the polygon.  Until this is called, the
+    // polygon is one ring of all n vertices.
+    void SetRings(const int* start, int nrings) {
+        R = start;
+        nr = nrings;
+    }
+
+    // the ring vertex i is in
+    int Ring(int i) const {
+        int lo = 0, hi = nr;          // R[lo] <= i < R[hi]
+        while (hi - lo > 1) {
+            int m = (lo + hi) / 2;
+            if (R[m] <= i) lo = m;
+            else           hi = m;
+        }
+        return lo;
+    }
+
+    // ring k is vertices RingStart(k) to RingEnd(k)-1
+    int RingStart(int k) const { return (nr > 1) ? R[k] : 0; }
+    int RingEnd(int k) const   { return (nr > 1) ? R[k+1] : n; }
+
+    // the vertex after i around its ring; edge i is from i to Next(i)
+    int Next(int i) const {
+        int k = Ring(i);
+        return (i+1 < RingEnd(k)) ? i+1 : RingStart(k);
+    }
+
+public:
+    int n;
+    PointT<T> *V;  // should have n elements, V[n-1] != V[0]
+    int nr;        // number of rings, each one of at least 3 vertices
+
+private:
+    const char* xs;    // where vertex 0's x and y are
+    const char* ys;
+    size_t stride;     // bytes from one vertex to the next
+    const int* R;      // where the rings start, if nr > 1
+};
+
+typedef PolygonT<double> Polygon;
+
+// simple_Polygon(): test if a Polygon P is simple or not
+//     Input:  Pn = a polygon with n vertices V[], in Pn.nr rings
+//     Return: FALSE(0) = is NOT simple
+//             TRUE(1)  = IS simple
+//     With several rings, all of them are swept at once, and P is simple
+//     only if no ring crosses or touches itself or any other one: a hole
+//     touching its shell at a vertex makes P NOT simple.  So does a ring
+//     with a zero length edge (a repeated vertex, such as a closing vertex
+//     equal to the first), even one of only 3 vertices.
+//     Triangles, quads and convex polygons are answered without a sweep,
+//     and ones of under 48 vertices by testing their edges pair by pair,
+//     with SIMD instructions where the machine has them (MeetKernel.h).
+template <class T>
+bool simple_Polygon( PolygonT<T> &Pn );
+
+template <class T> struct EventT;
+template <class T> class SLsegT;
+template <class T> struct EngineWorkT;
+struct SweepStats;
+
+typedef EventT<double> Event;
+
+// the kinds of status tree (Status.h) simple_Polygon() can keep its
+// sweep line in: which is fastest depends on the data (fastest_Status())
+enum StatusKind {
+    STATUS_AVL,            // AVL tree
+    STATUS_RB,             // red-black tree
+    STATUS_BTREE,          // B+ tree, several segments to a node
+    STATUS_KINDS
+};
+
+// the ways simple_Polygon() can look for the edges that meet
+// (Engines.h), all giving the same answers: which is fastest depends
+// on the size of the polygon and how its edges are spread
+enum EngineKind {
+    ENGINE_SWEEP,          // the sweep, in a status tree
+    ENGINE_BRUTE,          // the edges in x order, each against the later
+                           // ones starting before it ends
+    ENGINE_GRID,           // the edges sharing a cell of a uniform grid
+    ENGINE_RTREE,          // a packed (STR) R-tree of the edges' boxes
+    ENGINE_KINDS,
+    ENGINE_AUTO = ENGINE_KINDS     // choose_Engine() picks one for each
+};
+
+// SweepContext: the memory a sweep works in, kept from one call to the
+// next.  Validating many polygons with one context only allocates while
+// the context grows to fit the largest of them.  A context may only be
+// used by one call at a time.
+template <class T>
+class SweepContextT {
+public:
+    SweepContextT();
+    ~SweepContextT();
+
+    StatusKind status;     // the status tree to use, STATUS_AVL at first
+    EngineKind engine;     // the engine to use, ENGINE_SWEEP at first
+    Pool     nodes;        // AVL or red-black tree nodes
+    Pool     blocks;       // B+ tree nodes
+    Pool     segs;         // sweep line segments
+    EventT<T>*  Edata;     // array of all events
+    EventT<T>*  Etmp;      // scratch space for sorting them
+    SLsegT<T>** Eseg;      // Eseg[i] is the chain in the tree at edge i
+    SLsegT<T>** Vq;        // chains waiting to step to their next edge
+    int      room;         // number of events Edata and Etmp can hold
+    EngineWorkT<T>* work;  // the other engines' memory, once one is used
+    SweepStats* stats;     // each call's counts, if built with SWEEP_STATS
+                           // (SweepStats.h), or 0 not to keep them
+
+    void     reserve( int ne );         // make room for ne events or edges
+    void     reset();                   // free everything for a new call
+
+private:
+    SweepContextT(const SweepContextT &);
+    SweepContextT & operator=(const SweepContextT &);
+};
+
+typedef SweepContextT<double> SweepContext;
+
+// simple_Polygon(): as above, working in the memory of context C
+template <class T>
+bool simple_Polygon( PolygonT<T> &Pn, SweepContextT<T> &C );
+
+// simple_Polygons(): test a batch of polygons, spread over several threads
+//     Input:  P[np] = the polygons
+//             nthreads = threads to use, 0 => one per core
+//             status = the status tree to sweep with
+//             engine = the engine to use (Engines.h)
+//     Output: S[np], S[i] = simple_Polygon(*P[i])
+//             stats[np], stats[i] = the counts of that call, if given
+void simple_Polygons( Polygon* const P[], int np, bool S[], int nthreads=0,
+                      StatusKind status=STATUS_AVL, SweepStats stats[]=0,
+                      EngineKind engine=ENGINE_SWEEP );
+
+// choose_Engine(): the engine likely fastest for Pn, from its vertex
+// count and the boxes of it and its edges, as ENGINE_AUTO uses
+template <class T>
+EngineKind choose_Engine( const PolygonT<T> &Pn );
+
+// fastest_Status(): time simple_Polygon() with each kind of status tree
+// on a sample of the data, to pick one for the rest of it
+//     Input:  P[np] = the sample polygons
+//     Output: ms[STATUS_KINDS], ms[k] = milliseconds kind k took, if given
+//     Return: the fastest kind
+StatusKind fastest_Status( Polygon* const P[], int np, double ms[]=0 );
+
+// parallel_simple_Polygon(): test if one big Polygon P is simple,
+// sweeping vertical slabs of it on several threads
+//     Input:  Pn = a polygon with n vertices V[]
+//             nthreads = threads to use, 0 => one per core
+//     Return: simple_Polygon(Pn), for any nthreads
+bool parallel_simple_Polygon( Polygon &Pn, int nthreads=0 );
+
+// slab_Simple(): simple_Polygon()'s sweep over just the edges of Pn that
+// meet the slab x0 <= x <= x1, for parallel_simple_Polygon()
+//     Input:  stop = set when another slab has found two edges meeting
+//     Return: FALSE(0) = two edges meet, so Pn is NOT simple
+//             TRUE(1)  = none meet in the slab, or the sweep was stopped
+bool slab_Simple( Polygon &Pn, SweepContext &C, double x0, double x1,
+                  const std::atomic<bool>* stop=0 );
+
+template <class T> struct XMeventT;
+
+// ExternalSweep: simple_Polygon() for a polygon too big to hold in
+// memory, its vertices streamed in ring by ring.  The left end events of
+// its edges are sorted in runs that fit the memory budget, spilled to
+// temporary files, and merged back into the sweep; the only other memory
+// is the edges crossing the sweep line, and how wide that gets is up to
+// the data.  Edges are numbered in 64 bits, so there is no limit on the
+// vertices but disk space (48 bytes an edge for doubles).
+//
+//     ExternalSweep X(1 << 30);           // 1 GB for sorting
+//     while (...)
+//         X.Add(x, y);                    // ring 0, then
+//     X.EndRing();                        // the next ring, if any...
+//     bool simple = X.Simple();
+//
+// The answer is simple_Polygon()'s for the same rings.  A file error
+// throws std::runtime_error.
+template <class T>
+class ExternalSweepT {
+public:
+    // sort in 'budget' bytes, with temporary files in directory 'tmpdir',
+    // or where tmpfile() puts them if it is 0
+    ExternalSweepT(size_t budget = (size_t)256 << 20, const char* tmpdir = 0);
+    ~ExternalSweepT();
+
+    StatusKind status;     // the status tree to use, STATUS_AVL at first
+
+    void     Add( T x, T y );           // the next vertex of the ring
+    void     EndRing();                 // close the ring, start the next
+    bool     Simple();                  // the answer, once all are added;
+                                        // then it starts again, empty
+
+private:
+    size_t   room;         // events Run can hold
+    size_t   nrun;         // events in it
+    XMeventT<T>* Run;      // the events not yet spilled
+    std::vector<FILE*> Files;  // the sorted runs spilled so far
+    std::string Dir;       // tmpdir, if given
+    size_t   budget;
+    int64_t  ne;           // edges so far
+    int64_t  ring;         // edge number of the ring's first edge
+    PointT<T> first;       // the ring's first vertex
+    PointT<T> last;        // the last vertex added
+    bool     open;         // a ring has been started
+    bool     degenerate;   // an edge of zero length was added
+
+    void     edge( const PointT<T> &a, const PointT<T> &b, int64_t next );
+    void     spill();
+    FILE*    tmp();
+
+    ExternalSweepT(const ExternalSweepT &);
+    ExternalSweepT & operator=(const ExternalSweepT &);
+};
+
+typedef ExternalSweepT<double> ExternalSweep;
+
+// a pair of polygon edges that meet somewhere other than a shared vertex,
+// or a pair of segments of a segment set that meet
+typedef struct {
+    int   e1, e2;      // the two edges, e1 < e2 (edge i is V[i] to V[Next(i)],
+                       // or segment S[i] of a set)
+    Point P;           // a point where they meet
+} Crossing;
+
+// all_Crossings(): find every pair of non-adjacent edges that intersect
+//     Input:  Pn = a polygon with n vertices V[]
+//     Output: X  = one Crossing per intersecting pair, sorted by (e1, e2)
+//     Return: the number of crossings (0 => Pn IS simple)
+int all_Crossings( Polygon &Pn, std::vector<Crossing> &X );
+
+// a segment of a segment set, such as a piece of a road polyline
+typedef struct {
+    Point a, b;        // its end points, in either order
+    int   id;          // the caller's name for it, passed to an IgnorePair
+} Segment;
+
+// IgnorePair: return true if segments id1 and id2 may meet, such as
+// consecutive pieces of one polyline
+typedef bool (*IgnorePair)( int id1, int id2, void* arg );
+
+// all_Crossings(): find every pair of segments in a set that intersect
+//     Input:  S[ns] = the segments
+//             ignore = pairs not to report: those for which
+//                      ignore(S[e1].id, S[e2].id, arg) is true, if given
+//     Output: X  = one Crossing per intersecting pair, sorted by (e1, e2),
+//                  e1 and e2 being where the segments are in S[]
+//     Return: the number of crossings
+//     The polygon all_Crossings() above is this, with the polygon's
+//     edges as S[] and consecutive edges of a ring ignored.
+int all_Crossings( const Segment S[], int ns, std::vector<Crossing> &X,
+                   IgnorePair ignore=0, void* arg=0 );
+
+#endif /* SIMPLE_POLYGON_H_ */
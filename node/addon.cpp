@@ -0,0 +1,389 @@
+// addon.cpp - The C++ sweeps as a Node.js addon (N-API), for lib/native.js
+// Coordinates come in as a Float64Array of x,y pairs, which the sweep
+// reads where it lies: a Polygon view (simple_polygon.h) on the array's
+// buffer, with nothing copied or marshalled point by point.  A ring
+// split is an Int32Array of ring starts, as for Polygon::SetRings().
+//
+//     isSimple(coords [, rings])              => boolean
+//     isSimpleAsync(coords [, rings])         => Promise<boolean>
+//     simplePolygons(coords, starts [, threads]) => Promise<Uint8Array>
+//     crossings(coords [, rings])             => { edges: Int32Array,
+//                                                  points: Float64Array }
+//
+// The async calls sweep on the libuv thread pool, holding references to
+// the arrays until they are done; the caller must not change the arrays
+// meanwhile.  Bad arguments throw a TypeError or RangeError; a sweep that
+// throws (out of memory) rejects the promise, or throws, with an Error.
+
+#define NAPI_VERSION 3
+#include <node_api.h>
+#include <exception>
+#include <string>
+#include <vector>
+#include "simple_polygon.h"
+
+// N_CALL(): make an N-API call, and return 0 from the function calling
+// it if it failed (an exception is then pending in JS)
+#define N_CALL(env, call)                                               \
+    do {                                                                \
+        if ((call) != napi_ok) {                                        \
+            N_pending(env);                                             \
+            return (napi_value)0;                                       \
+        }                                                               \
+    } while (0)
+
+// N_pending(): make sure a failed call leaves an exception pending
+static void N_pending( napi_env env )
+{
+    bool pending = false;
+    napi_is_exception_pending(env, &pending);
+    if (pending)
+        return;
+    const napi_extended_error_info* info = (const napi_extended_error_info*)0;
+    napi_get_last_error_info(env, &info);
+    napi_throw_error(env, (const char*)0, (info && info->error_message)
+                                          ? info->error_message : "N-API call failed");
+}
+
+// N_typed(): the data and length of typed array v, if it is one of type
+// 'type'; otherwise throw a TypeError saying 'what' it should be
+static bool N_typed( napi_env env, napi_value v, napi_typedarray_type type,
+                     const char* what, void** data, size_t* length )
+{
+    bool is = false;
+    napi_typedarray_type t;
+    napi_value buffer;
+    size_t offset;
+    if (napi_is_typedarray(env, v, &is) != napi_ok || !is
+        || napi_get_typedarray_info(env, v, &t, length, data, &buffer, &offset) != napi_ok
+        || t != type) {
+        napi_throw_type_error(env, (const char*)0, what);
+        return false;
+    }
+    return true;
+}
+
+// N_given(): if argument i of argc is there and not undefined
+static bool N_given( napi_env env, napi_value* argv, size_t argc, size_t i )
+{
+    napi_valuetype t = napi_undefined;
+    return i < argc && napi_typeof(env, argv[i], &t) == napi_ok && t != napi_undefined;
+}
+//===================================================================
+
+
+// a polygon given from JS: its coordinates and rings, where JS has them
+struct Shape {
+    const double* xy;      // n x,y pairs
+    int         n;
+    const int*  R;         // the ring starts, R[0] = 0 ... R[nr] = n
+    int         nr;        // 0 if one ring
+};
+
+// S_check(): if ring starts R[nr+1] split n vertices into rings of at
+// least 3 (PolygonT::SetRings()); otherwise throw a RangeError
+static bool S_check( napi_env env, const int* R, int nr, int n )
+{
+    bool ok = nr >= 1 && R[0] == 0 && R[nr] == n;
+    for (int k=0; ok && k < nr; k++)
+        ok = R[k+1] - R[k] >= 3;
+    if (!ok)
+        napi_throw_range_error(env, (const char*)0,
+                               "rings must start at 0, end at the vertex count, "
+                               "and have at least 3 vertices each");
+    return ok;
+}
+
+// S_args(): the shape in coords (argv[0]) and rings (argv[1], if given)
+static bool S_args( napi_env env, napi_value* argv, size_t argc, Shape &S )
+{
+    void*  data;
+    size_t len;
+    if (argc < 1 || !N_typed(env, argv[0], napi_float64_array,
+                             "coords must be a Float64Array of x,y pairs", &data, &len))
+        return false;
+    if (len % 2 != 0 || len / 2 > (size_t)INT32_MAX) {
+        napi_throw_range_error(env, (const char*)0,
+                               "coords must hold whole x,y pairs, under 2^31 of them");
+        return false;
+    }
+    S.xy = (const double*)data;
+    S.n = (int)(len / 2);
+    S.R = (const int*)0;
+    S.nr = 0;
+    if (!N_given(env, argv, argc, 1))
+        return true;
+    if (!N_typed(env, argv[1], napi_int32_array,
+                 "rings must be an Int32Array of ring starts", &data, &len))
+        return false;
+    if (len < 2 || len - 1 > (size_t)INT32_MAX) {
+        napi_throw_range_error(env, (const char*)0, "rings must have at least 2 entries");
+        return false;
+    }
+    S.R = (const int*)data;
+    S.nr = (int)(len - 1);
+    return S_check(env, S.R, S.nr, S.n);
+}
+
+// S_polygon(): a view of shape S, to sweep
+static Polygon* S_polygon( const Shape &S )
+{
+    Polygon* P = new Polygon(S.xy, S.xy + 1, S.n, 2 * sizeof(double));
+    if (S.nr > 1)
+        P->SetRings(S.R, S.nr);
+    return P;
+}
+
+// S_simple(): simple_Polygon() of shape S
+static bool S_simple( const Shape &S )
+{
+    Polygon* P = S_polygon(S);
+    bool simple;
+    try {
+        simple = simple_Polygon(*P);
+    }
+    catch (...) {
+        delete P;
+        throw;
+    }
+    delete P;
+    return simple;
+}
+//===================================================================
+
+
+// isSimple(coords [, rings])
+static napi_value isSimple( napi_env env, napi_callback_info info )
+{
+    size_t     argc = 2;
+    napi_value argv[2];
+    Shape      S;
+    N_CALL(env, napi_get_cb_info(env, info, &argc, argv, (napi_value*)0, (void**)0));
+    if (!S_args(env, argv, argc, S))
+        return (napi_value)0;
+
+    bool simple;
+    try {
+        simple = S_simple(S);
+    }
+    catch (std::exception &e) {
+        napi_throw_error(env, (const char*)0, e.what());
+        return (napi_value)0;
+    }
+    napi_value r;
+    N_CALL(env, napi_get_boolean(env, simple, &r));
+    return r;
+}
+
+// crossings(coords [, rings]): all_Crossings(), edge pairs e1,e2 and
+// points x,y, crossing k being entries 2k and 2k+1 of each
+static napi_value crossings( napi_env env, napi_callback_info info )
+{
+    size_t     argc = 2;
+    napi_value argv[2];
+    Shape      S;
+    N_CALL(env, napi_get_cb_info(env, info, &argc, argv, (napi_value*)0, (void**)0));
+    if (!S_args(env, argv, argc, S))
+        return (napi_value)0;
+
+    std::vector<Crossing> X;
+    try {
+        Polygon* P = S_polygon(S);
+        try {
+            all_Crossings(*P, X);
+        }
+        catch (...) {
+            delete P;
+            throw;
+        }
+        delete P;
+    }
+    catch (std::exception &e) {
+        napi_throw_error(env, (const char*)0, e.what());
+        return (napi_value)0;
+    }
+
+    size_t     nx = X.size();
+    napi_value eb, pb, edges, points, r;
+    void*      e;
+    void*      p;
+    N_CALL(env, napi_create_arraybuffer(env, 2 * nx * sizeof(int32_t), &e, &eb));
+    N_CALL(env, napi_create_arraybuffer(env, 2 * nx * sizeof(double), &p, &pb));
+    for (size_t k=0; k < nx; k++) {
+        ((int32_t*)e)[2*k] = X[k].e1;
+        ((int32_t*)e)[2*k+1] = X[k].e2;
+        ((double*)p)[2*k] = X[k].P.x;
+        ((double*)p)[2*k+1] = X[k].P.y;
+    }
+    N_CALL(env, napi_create_typedarray(env, napi_int32_array, 2 * nx, eb, 0, &edges));
+    N_CALL(env, napi_create_typedarray(env, napi_float64_array, 2 * nx, pb, 0, &points));
+    N_CALL(env, napi_create_object(env, &r));
+    N_CALL(env, napi_set_named_property(env, r, "edges", edges));
+    N_CALL(env, napi_set_named_property(env, r, "points", points));
+    return r;
+}
+//===================================================================
+
+
+// a sweep on the thread pool: one polygon (isSimpleAsync) or a batch of
+// them (simplePolygons), and the references that keep their arrays alive
+struct Job {
+    napi_async_work work;
+    napi_deferred deferred;
+    napi_ref    ref[2];    // the arguments' arrays
+    Shape       S;         // the polygon, or all the batch's coordinates
+    int         np;        // polygons in a batch, or 0 for one
+    int         nthreads;
+    std::vector<char> out; // simple or not, for each
+    std::string error;     // what the sweep threw, if it did
+};
+
+// J_execute(): the sweep, off the JS thread; no N-API calls here
+static void J_execute( napi_env, void* data )
+{
+    Job* J = (Job*)data;
+    try {
+        if (J->np == 0) {
+            J->out.assign(1, S_simple(J->S));
+            return;
+        }
+        std::vector<Polygon*> P(J->np, (Polygon*)0);
+        bool* S = new bool[J->np];
+        for (int i=0; i < J->np; i++) {
+            const int* R = J->S.R;
+            P[i] = new Polygon(J->S.xy + 2 * R[i], J->S.xy + 2 * R[i] + 1,
+                               R[i+1] - R[i], 2 * sizeof(double));
+        }
+        simple_Polygons(&P[0], J->np, S, J->nthreads);
+        J->out.assign(S, S + J->np);
+        for (int i=0; i < J->np; i++)
+            delete P[i];
+        delete [] S;
+    }
+    catch (std::exception &e) {
+        J->error = e.what();
+    }
+}
+
+// J_complete(): settle the promise, back on the JS thread
+static void J_complete( napi_env env, napi_status status, void* data )
+{
+    Job* J = (Job*)data;
+    napi_value r = (napi_value)0;
+    if (status != napi_ok)
+        J->error = "the sweep was cancelled";
+    else if (J->error.empty() && J->np == 0)
+        napi_get_boolean(env, J->out[0] != 0, &r);
+    else if (J->error.empty()) {
+        napi_value b;
+        void*      d;
+        if (napi_create_arraybuffer(env, J->np, &d, &b) == napi_ok
+            && napi_create_typedarray(env, napi_uint8_array, J->np, b, 0, &r) == napi_ok)
+            memcpy(d, &J->out[0], J->np);
+        else
+            r = (napi_value)0;
+    }
+    if (r)
+        napi_resolve_deferred(env, J->deferred, r);
+    else {
+        napi_value msg, err;
+        bool pending = false;
+        napi_is_exception_pending(env, &pending);
+        if (pending)
+            napi_get_and_clear_last_exception(env, &err);
+        else {
+            napi_create_string_utf8(env, J->error.empty() ? "out of memory"
+                                                          : J->error.c_str(),
+                                    NAPI_AUTO_LENGTH, &msg);
+            napi_create_error(env, (napi_value)0, msg, &err);
+        }
+        napi_reject_deferred(env, J->deferred, err);
+    }
+    for (int k=0; k < 2; k++)
+        if (J->ref[k])
+            napi_delete_reference(env, J->ref[k]);
+    napi_delete_async_work(env, J->work);
+    delete J;
+}
+
+// J_queue(): hold argv[0..nref-1], and start job J, whose promise is *r
+static napi_value J_queue( napi_env env, Job* J, napi_value* argv, int nref,
+                           const char* name )
+{
+    napi_value promise, resource;
+    J->ref[0] = J->ref[1] = (napi_ref)0;
+    if (napi_create_promise(env, &J->deferred, &promise) != napi_ok
+        || napi_create_string_utf8(env, name, NAPI_AUTO_LENGTH, &resource) != napi_ok) {
+        delete J;
+        N_pending(env);
+        return (napi_value)0;
+    }
+    for (int k=0; k < nref; k++)
+        napi_create_reference(env, argv[k], 1, &J->ref[k]);
+    napi_create_async_work(env, (napi_value)0, resource, J_execute, J_complete,
+                           J, &J->work);
+    napi_queue_async_work(env, J->work);
+    return promise;
+}
+
+// isSimpleAsync(coords [, rings])
+static napi_value isSimpleAsync( napi_env env, napi_callback_info info )
+{
+    size_t     argc = 2;
+    napi_value argv[2];
+    Shape      S;
+    N_CALL(env, napi_get_cb_info(env, info, &argc, argv, (napi_value*)0, (void**)0));
+    if (!S_args(env, argv, argc, S))
+        return (napi_value)0;
+
+    Job* J = new Job;
+    J->S = S;
+    J->np = 0;
+    J->nthreads = 1;
+    return J_queue(env, J, argv, J->S.R ? 2 : 1, "sweepline.isSimpleAsync");
+}
+
+// simplePolygons(coords, starts [, threads]): polygon i is vertices
+// starts[i] to starts[i+1]-1, one ring each; swept on 'threads' threads
+// (1, the default, as the thread pool has others; 0 => one per core)
+static napi_value simplePolygons( napi_env env, napi_callback_info info )
+{
+    size_t     argc = 3;
+    napi_value argv[3];
+    Shape      S;
+    int32_t    nthreads = 1;
+    N_CALL(env, napi_get_cb_info(env, info, &argc, argv, (napi_value*)0, (void**)0));
+    if (argc < 2) {
+        napi_throw_type_error(env, (const char*)0, "simplePolygons(coords, starts)");
+        return (napi_value)0;
+    }
+    if (!S_args(env, argv, 2, S))
+        return (napi_value)0;
+    if (N_given(env, argv, argc, 2)
+        && (napi_get_value_int32(env, argv[2], &nthreads) != napi_ok || nthreads < 0)) {
+        napi_throw_range_error(env, (const char*)0, "threads must be 0 or more");
+        return (napi_value)0;
+    }
+
+    Job* J = new Job;
+    J->S = S;
+    J->np = S.nr;
+    J->nthreads = nthreads;
+    return J_queue(env, J, argv, 2, "sweepline.simplePolygons");
+}
+//===================================================================
+
+
+static napi_value Init( napi_env env, napi_value exports )
+{
+    napi_property_descriptor F[] = {
+        { "isSimple",       0, isSimple,       0, 0, 0, napi_default, 0 },
+        { "isSimpleAsync",  0, isSimpleAsync,  0, 0, 0, napi_default, 0 },
+        { "simplePolygons", 0, simplePolygons, 0, 0, 0, napi_default, 0 },
+        { "crossings",      0, crossings,      0, 0, 0, napi_default, 0 },
+    };
+    N_CALL(env, napi_define_properties(env, exports, sizeof(F) / sizeof(F[0]), F));
+    return exports;
+}
+
+NAPI_MODULE(NODE_GYP_MODULE_NAME, Init)
@@ -0,0 +1,176 @@
+// Tests of lib/native.js, the C++ sweep as a Node.js addon.  Plain
+// assert, so it runs without mocha:
+//
+//	SWEEPLINE_NATIVE=build/sweepline.node node test/native_test.js
+var assert = require('assert'),
+	native = require('../lib/native'),
+	Point = require('../lib').Point;
+
+var NativePolygon = native.Polygon;
+
+function points(geom) {
+	return geom.map(function (pnt) {
+		return new Point(pnt[0], pnt[1]);
+	});
+}
+
+// a seeded generator, so a failure can be repeated
+var seed = 12345;
+function random() {
+	seed = (seed * 1103515245 + 12345) % 2147483648;
+	return seed / 2147483648;
+}
+
+// n vertices round a star, simple, or with vertex k pulled across it
+// and out the far side
+function star(n, k) {
+	var coords = new Float64Array(2 * n);
+	for (var i = 0; i < n; i++) {
+		var a = 2 * Math.PI * i / n, r = 0.5 + 0.5 * random();
+		if (i === k) {
+			a += Math.PI;
+			r = 1.5;
+		}
+		coords[2 * i] = r * Math.cos(a);
+		coords[2 * i + 1] = r * Math.sin(a);
+	}
+	return coords;
+}
+
+var tests = [];
+function test(name, f) {
+	tests.push({ name: name, f: f });
+}
+
+test('the polygons of test.js give the same answers', function () {
+	var cases = [
+		[[[100.0, 0.0], [101.0, 0.0], [101.0, 1.0], [100.0, 1.0], [100.0, 0.0]], false],
+		[[[2.0, 2.0], [1.0, 2.0], [1.0, 1.0], [2.0, 1.0], [3.0, 1.0], [3.0, 2.0],
+			[2.00001, 2.000001]], true],
+		[[[0, 0], [0, 1], [1, 1], [1, 0], [0.0001, 0.00001]], true],
+		[[[2.0, 2.0], [2.0, 3.0], [3.0, 1.0], [4.0, 3.0], [4.0, 2.0]], false],
+		[[[2.0, 2.0], [3.0, 2.0], [3.0, 3.0], [2.0, 3.0], [4.0, 2.0]], false],
+		[[[116.305714, 40.061918], [116.313008, 40.056175], [116.303774, 40.048471],
+			[116.320554, 40.059433], [116.307403, 40.058771], [116.318578, 40.046317],
+			[116.310565, 40.058356], [116.310062, 40.051205], [116.313368, 40.05808],
+			[116.305714, 40.061918]], false]
+	];
+	cases.forEach(function (c, i) {
+		var P = new NativePolygon(points(c[0]));
+		assert.strictEqual(P.vertices.length, c[0].length);
+		assert.strictEqual(P.isSimplePolygon(), c[1], 'case ' + i);
+		assert.strictEqual(new NativePolygon(c[0]).isSimplePolygon(), c[1], 'pairs ' + i);
+	});
+});
+
+// simple or not, by testing every pair of edges that are not consecutive
+// (random points are in general position: no touching or collinear edges)
+function brute(geom) {
+	function isLeft(p0, p1, p2) {
+		return (p1.x - p0.x) * (p2.y - p0.y) - (p2.x - p0.x) * (p1.y - p0.y);
+	}
+	var n = geom.length;
+	for (var i = 0; i < n; i++) {
+		for (var j = i + 2; j < n; j++) {
+			if (i === 0 && j === n - 1) {
+				continue;
+			}
+			var a = geom[i], b = geom[i + 1], c = geom[j], d = geom[(j + 1) % n];
+			if (isLeft(a, b, c) * isLeft(a, b, d) < 0 && isLeft(c, d, a) * isLeft(c, d, b) < 0) {
+				return false;
+			}
+		}
+	}
+	return true;
+}
+
+// (the JS sweep of lib/polygon.js calls one of these simple that is not)
+test('random polygons agree with testing every pair of edges', function () {
+	for (var t = 0; t < 500; t++) {
+		var n = 3 + Math.floor(random() * 30), geom = [];
+		for (var i = 0; i < n; i++) {
+			geom.push(new Point(random(), random()));
+		}
+		assert.strictEqual(new NativePolygon(geom).isSimplePolygon(), brute(geom),
+			'polygon ' + t);
+	}
+});
+
+test('a Float64Array is swept where it is', function () {
+	var coords = star(1000, -1);
+	var P = new NativePolygon(coords);
+	assert.strictEqual(P.coords, coords);
+	assert.ok(P.isSimplePolygon());
+	coords[0] = -2;			// vertex 0 out past the far side
+	assert.ok(!P.isSimplePolygon());
+});
+
+test('rings, and the crossings between them', function () {
+	var coords = new Float64Array([0, 0, 4, 0, 4, 4, 0, 4,	// shell
+		1, 1, 3, 1, 3, 3, 1, 3]);			// hole
+	assert.ok(new NativePolygon(coords, new Int32Array([0, 4, 8])).isSimplePolygon());
+	coords[8] = -1;					// the hole out through the shell
+	var P = new NativePolygon(coords, new Int32Array([0, 4, 8]));
+	assert.ok(!P.isSimplePolygon());
+	var X = P.crossings();
+	assert.ok(X.edges instanceof Int32Array && X.points instanceof Float64Array);
+	assert.strictEqual(X.edges.length, 4);
+	assert.deepStrictEqual(Array.from(X.edges), [3, 4, 3, 7]);
+	assert.deepStrictEqual(Array.from(X.points), [0, 1, 0, 2]);
+});
+
+test('bad arguments throw', function () {
+	assert.throws(function () { native.addon.isSimple([0, 0, 1, 0, 1, 1]); }, TypeError);
+	assert.throws(function () { native.addon.isSimple(new Float64Array(5)); }, RangeError);
+	assert.throws(function () {
+		native.addon.isSimple(new Float64Array(8), new Int32Array([0, 2, 4]));
+	}, RangeError);
+	assert.throws(function () {
+		native.addon.isSimple(new Float64Array(8), new Float64Array([0, 4]));
+	}, TypeError);
+});
+
+test('large polygons are swept off the event loop', function () {
+	var simple = star(100000, -1), bad = star(100000, 777);
+	return Promise.all([
+		new NativePolygon(simple).isSimplePolygonAsync(),
+		new NativePolygon(bad).isSimplePolygonAsync(),
+		new NativePolygon(star(10, -1)).isSimplePolygonAsync()
+	]).then(function (r) {
+		assert.deepStrictEqual(r, [true, false, true]);
+	});
+});
+
+test('a batch comes back as a Uint8Array', function () {
+	var n = [5, 100, 7, 3000], k = [-1, 50, 3, -1];
+	var starts = new Int32Array(n.length + 1), parts = [];
+	for (var i = 0; i < n.length; i++) {
+		parts.push(star(n[i], k[i]));
+		starts[i + 1] = starts[i] + n[i];
+	}
+	var coords = new Float64Array(2 * starts[n.length]);
+	parts.forEach(function (p, i) { coords.set(p, 2 * starts[i]); });
+	return native.simplePolygons(coords, starts).then(function (S) {
+		assert.ok(S instanceof Uint8Array);
+		assert.deepStrictEqual(Array.from(S), [1, 0, 0, 1]);
+		return native.simplePolygons(coords, starts, 0);
+	}).then(function (S) {
+		assert.deepStrictEqual(Array.from(S), [1, 0, 0, 1]);
+	});
+});
+
+// run them in turn, waiting for any promise
+var failed = 0;
+tests.reduce(function (prev, t) {
+	return prev.then(function () {
+		return t.f();
+	}).then(function () {
+		console.log('ok   ' + t.name);
+	}, function (e) {
+		failed++;
+		console.log('FAIL ' + t.name + '\n' + (e.stack || e));
+	});
+}, Promise.resolve()).then(function () {
+	console.log(tests.length - failed + ' of ' + tests.length + ' passed');
+	process.exitCode = failed ? 1 : 0;
+});
@@ -0,0 +1,1211 @@
+// sl_test.cpp - Check the C++ sweeps against what is known to be right
+// The synthetic polygons are simple or not by construction; small random
+// polygons on a grid are checked against trying every pair of edges.
+// Prints each failure, and exits non-zero if there were any.
+
+#include <stdio.h>
+#include <math.h>
+#include <random>
+#include <vector>
+#include <string>
+#include <algorithm>
+#include <stdexcept>
+#include <chrono>
+#include "simple_polygon.h"
+#include "PolygonFile.h"
+#include "MeetKernel.h"
+#include "SimpleValidator.h"
+#include "SweepStats.h"
+#include "CleanPolygon.h"
+#include "EventQueue.h"
+#include "generators.h"
+
+#ifndef SL_TEST_DIR
+#define SL_TEST_DIR "."        // where the test files go: the build directory
+#endif
+
+static int failures = 0;
+
+#define CHECK(cond, ...)                                        \
+    do {                                                        \
+        if (!(cond)) {                                          \
+            failures++;                                         \
+            printf("FAIL %s:%d: ", __FILE__, __LINE__);         \
+            printf(__VA_ARGS__);                                \
+            printf("\n");                                       \
+        }                                                       \
+    } while (0)
+
+static const char* StatusName[STATUS_KINDS] = { "avl", "rb", "btree" };
+static const char* EngineName[ENGINE_KINDS + 1] = { "sweep", "brute", "grid",
+                                                   "rtree", "auto" };
+
+// every generator at several sizes, with every status tree, and the
+// all-crossings and parallel sweeps agreeing
+static void test_generators()
+{
+    SweepContext C;
+    for (int i=0; i < NGENERATORS; i++) {
+        const Generator &g = Generators[i];
+        for (int n = 10; n <= 100000; n *= 10)
+            for (unsigned seed = 1; seed <= (n < 100000 ? 3u : 1u); seed++) {
+                Polygon P(n);
+                g.make(P, seed);
+                for (int k=0; k < STATUS_KINDS; k++) {
+                    C.status = (StatusKind)k;
+                    CHECK(simple_Polygon(P, C) == g.simple,
+                          "%s n=%d seed=%u status=%s", g.name, n, seed,
+                          StatusName[k]);
+                }
+                std::vector<Crossing> X;
+                CHECK((all_Crossings(P, X) == 0) == g.simple,
+                      "all_Crossings %s n=%d seed=%u", g.name, n, seed);
+                CHECK(parallel_simple_Polygon(P, 4) == g.simple,
+                      "parallel_simple_Polygon %s n=%d seed=%u", g.name, n, seed);
+            }
+    }
+}
+
+static int sgn( double d ) { return (d > 0) - (d < 0); }
+
+static double orient( Point a, Point b, Point c )
+{
+    return (b.x - a.x) * (c.y - a.y) - (c.x - a.x) * (b.y - a.y);
+}
+
+static bool xyless( Point a, Point b )
+{
+    return a.x < b.x || (a.x == b.x && a.y < b.y);
+}
+
+// do closed segments ab and cd meet?
+static bool meet( Point a, Point b, Point c, Point d )
+{
+    int d1 = sgn(orient(a, b, c)), d2 = sgn(orient(a, b, d));
+    int d3 = sgn(orient(c, d, a)), d4 = sgn(orient(c, d, b));
+    if (d1 * d2 > 0 || d3 * d4 > 0)
+        return false;
+    if (d1 == 0 && d2 == 0) {      // collinear: do their xy ranges overlap?
+        if (xyless(b, a)) std::swap(a, b);
+        if (xyless(d, c)) std::swap(c, d);
+        return !xyless(b, c) && !xyless(d, a);
+    }
+    return true;
+}
+
+// brute_Crossings(): every pair of non-adjacent edges of P that meet,
+// sorted by (e1, e2)
+static void brute_Crossings( Polygon &P, std::vector<Crossing> &T )
+{
+    int n = P.n;
+    T.clear();
+    for (int i=0; i < n; i++)
+        for (int j=i+1; j < n; j++) {
+            if (j == i+1 || (i == 0 && j == n-1))
+                continue;
+            if (meet(P.V[i], P.V[(i+1)%n], P.V[j], P.V[(j+1)%n])) {
+                Crossing c;
+                c.e1 = i;
+                c.e2 = j;
+                T.push_back(c);
+            }
+        }
+}
+
+// random polygons of a few vertices on a small grid, where touching,
+// overlapping and repeated vertices are common
+static void test_brute_force()
+{
+    std::mt19937 rng(2024);
+    SweepContext C;
+    int nsimple = 0;
+    for (int it=0; it < 20000; it++) {
+        int n = 4 + rng() % 9;
+        int grid = 3 + rng() % 6;
+        Polygon P(n);
+        for (int i=0; i < n; i++) {
+            P.V[i].x = rng() % grid;
+            P.V[i].y = rng() % grid;
+        }
+
+        std::vector<Crossing> T;
+        brute_Crossings(P, T);
+        bool simple = T.empty();
+        nsimple += simple;
+
+        for (int k=0; k < STATUS_KINDS; k++) {
+            C.status = (StatusKind)k;
+            CHECK(simple_Polygon(P, C) == simple, "random polygon %d status=%s",
+                  it, StatusName[k]);
+        }
+        std::vector<Crossing> X;
+        all_Crossings(P, X);
+        bool same = X.size() == T.size();
+        for (size_t c=0; same && c < X.size(); c++)
+            same = X[c].e1 == T[c].e1 && X[c].e2 == T[c].e2;
+        CHECK(same, "all_Crossings random polygon %d: %d crossings, not %d",
+              it, (int)X.size(), (int)T.size());
+    }
+    CHECK(nsimple > 1000 && nsimple < 19000, "%d of 20000 polygons simple",
+          nsimple);
+}
+
+// a star of n vertices (from 'at') about cx,cy, with radii from r0 to
+// r1, rounded to whole numbers: repeated vertices, and edges that touch
+// or overlap, are common
+static void grid_Star( std::mt19937 &rng, Polygon &P, int at, int n,
+                       double cx, double cy, int r0, int r1 )
+{
+    for (int i=0; i < n; i++) {
+        double a = 2 * M_PI * i / n;
+        double r = r0 + (int)(rng() % (r1 - r0 + 1));
+        P.V[at + i].x = floor(cx + r * cos(a) + 0.5);
+        P.V[at + i].y = floor(cy + r * sin(a) + 0.5);
+    }
+}
+
+// S_polyline(): segments id1 and id2 are pieces of one polyline, given
+// three to a polyline
+static bool S_polyline( int id1, int id2, void* arg )
+{
+    return id1 / 3 == id2 / 3 && arg == (void*)&S_polyline;
+}
+
+// random segment sets on a small grid, points and overlaps included,
+// their crossings checked pair for pair against meet(), with and without
+// ignoring the pieces of one polyline
+static void test_segments()
+{
+    std::mt19937 rng(1212);
+    for (int it=0; it < 10000; it++) {
+        int ns = rng() % 40;
+        int grid = 3 + rng() % 6;
+        std::vector<Segment> S(ns);
+        for (int i=0; i < ns; i++) {
+            S[i].a.x = rng() % grid;
+            S[i].a.y = rng() % grid;
+            S[i].b.x = rng() % grid;
+            S[i].b.y = rng() % grid;
+            S[i].id = (it % 2) ? i : ns - 1 - i;
+        }
+        bool ignoring = (it % 3) != 0;
+
+        std::vector<Crossing> T, X;
+        for (int i=0; i < ns; i++)
+            for (int j=i+1; j < ns; j++) {
+                if (ignoring && S_polyline(S[i].id, S[j].id, (void*)&S_polyline))
+                    continue;
+                if (meet(S[i].a, S[i].b, S[j].a, S[j].b)) {
+                    Crossing c;
+                    c.e1 = i;
+                    c.e2 = j;
+                    T.push_back(c);
+                }
+            }
+        int nx = ignoring ? all_Crossings(S.data(), ns, X, S_polyline,
+                                          (void*)&S_polyline)
+                          : all_Crossings(S.data(), ns, X);
+        bool same = nx == (int)X.size() && X.size() == T.size();
+        for (size_t c=0; same && c < X.size(); c++)
+            same = X[c].e1 == T[c].e1 && X[c].e2 == T[c].e2;
+        CHECK(same, "segment set %d: %d crossings, not %d", it, nx, (int)T.size());
+
+        // each crossing point on both segments, in their boxes at least
+        for (size_t c=0; c < X.size(); c++)
+            for (int k=0; k < 2; k++) {
+                const Segment &g = S[k ? X[c].e2 : X[c].e1];
+                const Point &P = X[c].P;
+                CHECK(P.x >= std::min(g.a.x, g.b.x) - 1e-9 &&
+                      P.x <= std::max(g.a.x, g.b.x) + 1e-9 &&
+                      P.y >= std::min(g.a.y, g.b.y) - 1e-9 &&
+                      P.y <= std::max(g.a.y, g.b.y) + 1e-9,
+                      "segment set %d: crossing %d,%d at %g,%g off segment %d",
+                      it, X[c].e1, X[c].e2, P.x, P.y, k ? X[c].e2 : X[c].e1);
+            }
+    }
+
+    // an empty polygon has no crossings
+    Polygon P(0);
+    std::vector<Crossing> X;
+    CHECK(all_Crossings(P, X) == 0 && parallel_simple_Polygon(P),
+          "empty polygon");
+}
+
+// views over the caller's coordinates: separate x[] and y[] arrays, and
+// records of an odd size with the coordinates unaligned in them, answer
+// as the polygon they were copied from does, in one ring or several
+static void test_views()
+{
+    std::mt19937 rng(1010);
+    const size_t REC = 21;             // a record: 1 byte, x, 4 bytes, y
+    for (int it=0; it < 2000; it++) {
+        bool gen = it < 2 * NGENERATORS;   // each generator, then random
+        int  n = gen ? 100 + 900 * (it % 2) : 3 + rng() % 60;
+        Polygon P(n);
+        if (gen)
+            Generators[it / 2].make(P, 1);
+        else {
+            for (int i=0; i < n; i++) {
+                P.V[i].x = rng() % 8;
+                P.V[i].y = rng() % 8;
+            }
+        }
+        int R[3] = { 0, n / 2, n };
+        bool rings = n >= 6 && it % 3 == 0;
+        if (rings)
+            P.SetRings(R, 2);
+
+        std::vector<double> X(n), Y(n);
+        std::vector<char> B(n * REC);
+        for (int i=0; i < n; i++) {
+            X[i] = P.V[i].x;
+            Y[i] = P.V[i].y;
+            memcpy(&B[i * REC + 1], &P.V[i].x, sizeof(double));
+            memcpy(&B[i * REC + 13], &P.V[i].y, sizeof(double));
+        }
+        Polygon Vs(X.data(), Y.data(), n);
+        Polygon Vr((const double*)&B[1], (const double*)&B[13], n, REC);
+        if (rings) {
+            Vs.SetRings(R, 2);
+            Vr.SetRings(R, 2);
+        }
+
+        bool simple = simple_Polygon(P);
+        std::vector<Crossing> XP, XS, XR;
+        int c = all_Crossings(P, XP);
+        CHECK(Vs.V == (Point*)0 && Vr.V == (Point*)0, "view %d owns V", it);
+        for (int i=0; i < n; i++) {
+            Point a = Vs.Vertex(i), b = Vr.Vertex(i);
+            CHECK(a.x == P.V[i].x && a.y == P.V[i].y &&
+                  b.x == P.V[i].x && b.y == P.V[i].y,
+                  "view %d: vertex %d read wrong", it, i);
+        }
+        CHECK(simple_Polygon(Vs) == simple && simple_Polygon(Vr) == simple,
+              "view %d (%d vertices, rings=%d): simple=%d", it, n, rings, simple);
+        CHECK(all_Crossings(Vs, XS) == c && all_Crossings(Vr, XR) == c,
+              "view %d: crossings differ from %d", it, c);
+    }
+}
+
+// every engine gives the sweep's answers: on the generators, and on
+// polygons on a small grid, big enough to need a sweep, with and without
+// holes, in double, in int32_t and in int64_t past 2^53, where a double
+// would round them
+static void test_engines()
+{
+    SweepContext C;
+    for (int i=0; i < NGENERATORS; i++) {
+        const Generator &g = Generators[i];
+        for (int n = 100; n <= 10000; n *= 10) {
+            Polygon P(n);
+            g.make(P, 1);
+            for (int e=0; e <= ENGINE_KINDS; e++) {
+                C.engine = (EngineKind)e;
+                CHECK(simple_Polygon(P, C) == g.simple, "%s n=%d engine=%s",
+                      g.name, n, EngineName[e]);
+            }
+        }
+    }
+
+    std::mt19937 rng(4242);
+    SweepContextT<int32_t> Ci;
+    SweepContextT<int64_t> Cl;
+    const int64_t X0 = ((int64_t)1 << 61) + 1, S = ((int64_t)1 << 54) + 1;
+    int nsimple = 0, nholes = 0;
+    for (int it=0; it < 3000; it++) {
+        int  n = 48 + rng() % 100;
+        int  nh = (it % 2) ? 0 : 8 + rng() % 40;     // a hole, or none
+        Polygon P(n + nh);
+        grid_Star(rng, P, 0, n, 0, 0, 8, 8 + rng() % 30);
+        int  R[3] = { 0, n, n + nh };
+        if (nh) {
+            grid_Star(rng, P, n, nh, rng() % 5, rng() % 5, 1, 2 + rng() % 8);
+            P.SetRings(R, 2);
+        }
+        std::vector<Crossing> T;
+        if (!nh)
+            brute_Crossings(P, T);
+        C.engine = ENGINE_SWEEP;
+        bool simple = simple_Polygon(P, C);
+        CHECK(nh || simple == T.empty(), "grid star %d: sweep wrong", it);
+        nsimple += simple;
+        nholes += simple && nh;
+
+        PolygonT<int32_t> Pi(n + nh);
+        PolygonT<int64_t> Pl(n + nh);      // scaled and moved: the same shape
+        for (int j=0; j < n + nh; j++) {
+            Pi.V[j].x = (int32_t)P.V[j].x;
+            Pi.V[j].y = (int32_t)P.V[j].y;
+            Pl.V[j].x = X0 + S * Pi.V[j].x;
+            Pl.V[j].y = X0 - S * Pi.V[j].y;
+        }
+        if (nh) {
+            Pi.SetRings(R, 2);
+            Pl.SetRings(R, 2);
+        }
+        for (int e=0; e <= ENGINE_KINDS; e++) {
+            C.engine = (EngineKind)e;
+            Ci.engine = (EngineKind)e;
+            Cl.engine = (EngineKind)e;
+            CHECK(simple_Polygon(P, C) == simple && simple_Polygon(Pi, Ci) == simple
+                  && simple_Polygon(Pl, Cl) == simple,
+                  "grid star %d (%d + %d vertices): engine=%s", it, n, nh,
+                  EngineName[e]);
+        }
+    }
+    CHECK(nsimple > 300 && nsimple < 2700 && nholes > 100,
+          "%d of 3000 grid stars simple, %d with holes", nsimple, nholes);
+
+    // a vertex reaching down to within a unit of an edge from (0,0) to
+    // (2L,2L+2), L = 2^59: above it, on it, or across it.  In double, all
+    // three would be on it.
+    const int64_t L = (int64_t)1 << 59;
+    for (int d=1; d >= -1; d--) {
+        static const int64_t V[5][2] = { {0,0}, {2,2}, {2,3}, {1,1}, {0,3} };
+        PolygonT<int64_t> Pl(5);
+        for (int j=0; j < 5; j++) {
+            Pl.V[j].x = V[j][0] * L - X0;
+            Pl.V[j].y = V[j][1] * L - X0 + (j == 1 ? 2 : 0) + (j == 3 ? 1 + d : 0);
+        }
+        for (int e=0; e <= ENGINE_KINDS; e++) {
+            Cl.engine = (EngineKind)e;
+            CHECK(simple_Polygon(Pl, Cl) == (d > 0),
+                  "int64 vertex %d off an edge: engine=%s", d, EngineName[e]);
+        }
+    }
+
+    // polygons too small to have a box: choose_Engine() reads no vertex
+    // that is not there, and picks a real engine
+    for (int n=0; n < 3; n++) {
+        Polygon P(n);
+        for (int j=0; j < n; j++)
+            P.V[j].x = P.V[j].y = j;
+        EngineKind e = choose_Engine(P);
+        C.engine = ENGINE_AUTO;
+        CHECK(e >= ENGINE_SWEEP && e < ENGINE_KINDS && simple_Polygon(P, C),
+              "%d vertices: chose %d", n, (int)e);
+    }
+}
+
+#if defined(EXACT_PREDICATES) && defined(__SIZEOF_INT128__)
+// ext_Gcd(): gcd(p, q) = p u + q v, for p, q >= 0
+static int64_t ext_Gcd( int64_t p, int64_t q, int64_t &u, int64_t &v )
+{
+    if (q == 0) {
+        u = 1;
+        v = 0;
+        return p;
+    }
+    int64_t g = ext_Gcd(q, p % q, v, u);
+    v -= (p / q) * u;
+    return g;
+}
+#endif
+
+// built with EXACT_PREDICATES: isLeft() has the exact sign on near
+// collinear triples where the plain double one is wrong, and so do the
+// answers of polygons that hang on it.  The points are whole numbers below
+// 2^53, so the exact sign is worked out in 128 bit integers.
+static void test_exact()
+{
+#if defined(EXACT_PREDICATES) && defined(__SIZEOF_INT128__)
+    std::mt19937_64 rng(53);
+    SweepContext C;
+    int nwrong = 0, nzero = 0;
+    for (int it=0; it < 200000; it++) {
+        // b = a + k (dx,dy) and c = a + j (dx,dy) + s (ex,ey), 0 < j < k,
+        // with dx ey - dy ex = gcd(dx,dy): c is on ab, or as near either
+        // side of it as a whole number point can be
+        int64_t ax = (int64_t)(rng() % ((uint64_t)1 << 52)) - ((int64_t)1 << 51);
+        int64_t ay = (int64_t)(rng() % ((uint64_t)1 << 51)) - ((int64_t)1 << 51);
+        int     bits = 1 + rng() % 24;     // |(dx,dy)| about 2^bits
+        int64_t dx = 2 + rng() % ((uint64_t)1 << bits);
+        int64_t dy = (int64_t)(rng() % ((uint64_t)2 << bits)) - ((int64_t)1 << bits);
+        int64_t k = 2 + rng() % ((uint64_t)1 << (49 - bits));
+        int64_t j = 1 + rng() % (k - 1);
+        int64_t s = (int64_t)(rng() % 3) - 1, ex, ey;
+        ext_Gcd(dx, dy < 0 ? -dy : dy, ey, ex);
+        ex = (dy < 0) ? ex : -ex;
+        ex *= s;
+        ey *= s;
+        Point a = { (double)ax, (double)ay };
+        Point b = { (double)(ax + k * dx), (double)(ay + k * dy) };
+        Point c = { (double)(ax + j * dx + ex), (double)(ay + j * dy + ey) };
+
+        __int128 det = (__int128)(k * dx) * (j * dy + ey)
+                     - (__int128)(j * dx + ex) * (k * dy);
+        int exact = (det > 0) - (det < 0);
+        nwrong += sgn(orient(a, b, c)) != exact;
+        nzero += exact == 0;
+        CHECK(sgn(isLeft(a, b, c)) == exact,
+              "exact %d: isLeft() sign %d, not %d", it, sgn(isLeft(a, b, c)),
+              exact);
+        if (it % 16)
+            continue;
+
+        // a, b, then up and back in a staircase over c, and down to c: a
+        // polygon that is simple just when c is above ab, so left of it.
+        // Four vertices are answered without a sweep, 54 with one.
+        double top = std::max(a.y, std::max(b.y, c.y)) + (1 << 20);
+        for (int m=0; m <= 50; m += 50) {
+            Polygon P(m + 4);
+            P.V[0] = a;
+            P.V[1] = b;
+            for (int i=0; i < m; i++) {
+                P.V[2+i].x = b.x - floor((b.x - c.x) * i / m);
+                P.V[2+i].y = top + i;
+            }
+            P.V[m+2].x = c.x;
+            P.V[m+2].y = top + m;
+            P.V[m+3] = c;
+            CHECK(simple_Polygon(P, C) == (exact > 0),
+                  "exact %d: %d vertices, c on side %d of ab", it, m + 4,
+                  exact);
+        }
+    }
+    CHECK(nwrong > 10000 && nzero > 10000,
+          "exact: %d plain double signs wrong, %d collinear", nwrong, nzero);
+#endif
+}
+
+// every MeetKernel this machine has: the same bits as the scalar one,
+// and a sure answer only where it is right.  Half the blocks are on a
+// small grid, where touching and collinear segments are common.
+static void test_kernel()
+{
+    static const char* IsaName[ISA_KINDS] = { "scalar", "sse2", "avx2", "avx512" };
+    std::mt19937 rng(64);
+    std::uniform_real_distribution<double> u(-1, 1);
+    double lx[64 + KERNEL_PAD], ly[64 + KERNEL_PAD];
+    double rx[64 + KERNEL_PAD], ry[64 + KERNEL_PAD];
+    MeetKernel K0 = meet_Kernel(ISA_SCALAR);
+    CHECK(meet_Kernel(best_Isa()) != 0, "no kernel for %s", IsaName[best_Isa()]);
+
+    for (int it=0; it < 20000; it++) {
+        int  m = 1 + rng() % 64;
+        int  grid = (it % 2) ? 0 : 2 + rng() % 5;
+        Point p[2 * 65];
+        for (int j=0; j < 2 * (m+1); j++) {
+            p[j].x = grid ? rng() % grid : u(rng);
+            p[j].y = grid ? rng() % grid : u(rng);
+            if (j % 2 && xyless(p[j], p[j-1]))
+                std::swap(p[j], p[j-1]);
+        }
+        for (int j=0; j < m + KERNEL_PAD; j++) {
+            lx[j] = (j < m) ? p[2*j+2].x : 0;
+            ly[j] = (j < m) ? p[2*j+2].y : 0;
+            rx[j] = (j < m) ? p[2*j+3].x : 0;
+            ry[j] = (j < m) ? p[2*j+3].y : 0;
+        }
+        double   q[4] = { p[0].x, p[0].y, p[1].x, p[1].y };
+        uint64_t hit0, unsure0;
+        K0(q, lx, ly, rx, ry, m, &hit0, &unsure0);
+        for (int j=0; j < m; j++) {
+            bool m1 = meet(p[0], p[1], p[2*j+2], p[2*j+3]);
+            if (!((unsure0 >> j) & 1))
+                CHECK(((hit0 >> j) & 1) == m1, "kernel block %d lane %d", it, j);
+        }
+        for (int isa = ISA_SSE2; isa < ISA_KINDS; isa++) {
+            MeetKernel K = meet_Kernel((KernelIsa)isa);
+            if (!K)
+                continue;
+            uint64_t hit, unsure;
+            K(q, lx, ly, rx, ry, m, &hit, &unsure);
+            CHECK(hit == hit0 && unsure == unsure0, "%s kernel block %d",
+                  IsaName[isa], it);
+        }
+    }
+
+    // polygons of up to 47 vertices, which are tested pair by pair, and
+    // in float and integer coordinates as well, int64_t ones past 2^53
+    SweepContext C;
+    SweepContextT<float>   Cf;
+    SweepContextT<int32_t> Ci;
+    SweepContextT<int64_t> Cl;
+    const int64_t X0 = -((int64_t)1 << 61) + 5, S = ((int64_t)1 << 52) + 3;
+    for (int it=0; it < 5000; it++) {
+        int n = 13 + rng() % 35;
+        int grid = 4 + rng() % 12;
+        Polygon P(n);
+        PolygonT<float>   Pf(n);
+        PolygonT<int32_t> Pi(n);
+        PolygonT<int64_t> Pl(n);
+        for (int i=0; i < n; i++) {
+            Pi.V[i].x = rng() % grid;
+            Pi.V[i].y = rng() % grid;
+            Pf.V[i].x = P.V[i].x = Pi.V[i].x;
+            Pf.V[i].y = P.V[i].y = Pi.V[i].y;
+            Pl.V[i].x = X0 + S * Pi.V[i].x;
+            Pl.V[i].y = X0 + S * Pi.V[i].y;
+        }
+        std::vector<Crossing> T;
+        brute_Crossings(P, T);
+        bool simple = T.empty();
+        CHECK(simple_Polygon(P, C) == simple, "%d vertex polygon %d", n, it);
+        CHECK(simple_Polygon(Pf, Cf) == simple, "%d vertex float polygon %d", n, it);
+        CHECK(simple_Polygon(Pi, Ci) == simple, "%d vertex int32 polygon %d", n, it);
+        CHECK(simple_Polygon(Pl, Cl) == simple, "%d vertex int64 polygon %d", n, it);
+    }
+    for (int i=0; i < NGENERATORS; i++)
+        for (int n = 10; n < 48; n++) {
+            Polygon P(n);
+            Generators[i].make(P, n);
+            CHECK(simple_Polygon(P, C) == Generators[i].simple, "%s n=%d",
+                  Generators[i].name, n);
+        }
+}
+
+// convex polygons, which simple_Polygon() answers without a sweep, and
+// ones a vertex moved or repeated away from convex, which it must sweep
+static void test_convex()
+{
+    std::mt19937 rng(7);
+    SweepContext C;
+    for (int it=0; it < 5000; it++) {
+        // the convex hull of random points, counterclockwise
+        std::vector<Point> S(5 + rng() % 40), H(2 * S.size());
+        for (size_t i=0; i < S.size(); i++) {
+            S[i].x = rng() % 1000;
+            S[i].y = rng() % 1000;
+        }
+        std::sort(S.begin(), S.end(), xyless);
+        int h = 0;
+        for (int pass=0; pass < 2; pass++) {
+            int base = h;
+            for (size_t i=0; i < S.size(); i++) {
+                Point p = pass ? S[S.size() - 1 - i] : S[i];
+                while (h >= base + 2 && orient(H[h-2], H[h-1], p) <= 0)
+                    h--;
+                H[h++] = p;
+            }
+            h--;                   // the last is the next pass's first
+        }
+        if (h < 3)
+            continue;
+
+        int kind = it % 4;         // 0: convex, 1: a vertex moved,
+        int n = h + (kind == 2);   // 2: the first repeated at the end,
+        Polygon P(n);              // 3: two vertices swapped
+        for (int i=0; i < h; i++)
+            P.V[i] = H[i];
+        if (kind == 1) {
+            int i = rng() % h;
+            P.V[i].x = rng() % 1000;
+            P.V[i].y = rng() % 1000;
+        }
+        else if (kind == 2)
+            P.V[h] = H[0];
+        else if (kind == 3)
+            std::swap(P.V[0], P.V[1 + rng() % (h-1)]);
+
+        std::vector<Crossing> T;
+        brute_Crossings(P, T);
+        bool simple = T.empty();   // and no zero length edge, even if n = 3
+        for (int i=0; i < n; i++)
+            if (!xyless(P.V[i], P.V[(i+1)%n]) && !xyless(P.V[(i+1)%n], P.V[i]))
+                simple = false;
+        CHECK(kind != 0 || simple, "convex polygon %d not simple", it);
+        for (int k=0; k < STATUS_KINDS; k++) {
+            C.status = (StatusKind)k;
+            CHECK(simple_Polygon(P, C) == simple, "convex polygon %d kind=%d status=%s",
+                  it, kind, StatusName[k]);
+        }
+    }
+}
+
+// ExternalSweep: the answer simple_Polygon() gets, with runs spilled to
+// files and merged in more than one pass
+static void test_external()
+{
+    SweepContext C;
+    for (int i=0; i < NGENERATORS; i++) {
+        const Generator &g = Generators[i];
+        for (int n = 10; n <= 100000; n *= 100) {
+            Polygon P(n);
+            g.make(P, 1);
+            for (int k=0; k < STATUS_KINDS; k++) {
+                ExternalSweep X(4096);     // 1024 events to a run
+                X.status = (StatusKind)k;
+                for (int j=0; j < n; j++)
+                    X.Add(P.V[j].x, P.V[j].y);
+                CHECK(X.Simple() == g.simple, "ExternalSweep %s n=%d status=%s",
+                      g.name, n, StatusName[k]);
+            }
+        }
+    }
+
+    // random rings on a grid, one to three of them, as one polygon
+    std::mt19937 rng(99);
+    ExternalSweep X(4096);
+    for (int it=0; it < 20000; it++) {
+        int nr = 1 + rng() % 3;
+        int start[4] = { 0 };
+        for (int k=0; k < nr; k++)
+            start[k+1] = start[k] + 3 + rng() % 6;
+        int n = start[nr];
+        int grid = 3 + rng() % 8;
+        Polygon P(n);
+        for (int j=0; j < n; j++) {
+            P.V[j].x = rng() % grid;
+            P.V[j].y = rng() % grid;
+        }
+        P.SetRings(start, nr);
+        for (int k=0; k < nr; k++) {
+            for (int j = start[k]; j < start[k+1]; j++)
+                X.Add(P.V[j].x, P.V[j].y);
+            X.EndRing();
+        }
+        bool simple = simple_Polygon(P, C);
+        CHECK(X.Simple() == simple, "ExternalSweep random polygon %d, %d rings",
+              it, nr);
+    }
+}
+
+// V_polygon(): the polygon of rings R[], lists of a SimpleValidator's
+// vertex ids, into P
+static void V_polygon( const SimpleValidator &SV,
+                       const std::vector<std::vector<int> > &R,
+                       Polygon* &P, std::vector<int> &start )
+{
+    int n = 0;
+    start.assign(1, 0);
+    for (size_t k=0; k < R.size(); k++)
+        start.push_back(n += (int)R[k].size());
+    delete P;
+    P = new Polygon(n);
+    for (size_t k=0; k < R.size(); k++)
+        for (size_t j=0; j < R[k].size(); j++)
+            P->V[start[k] + j] = SV.Vertex(R[k][j]);
+    if (R.size() > 1)
+        P->SetRings(&start[0], (int)R.size());
+}
+
+// SimpleValidator: after every random move, insert and delete, the
+// answer simple_Polygon() gets for the polygon as it is then
+static void test_validator()
+{
+    std::mt19937 rng(20);
+    SweepContext C;
+    std::vector<int> start;
+    Polygon* P = (Polygon*)0;
+    for (int it=0; it < 300; it++) {
+        int nr = 1 + rng() % 2;
+        int grid = 4 + rng() % 20;
+        std::vector<std::vector<int> > R(nr);
+        for (int k=0, v=0; k < nr; k++)
+            for (int j = 3 + rng() % 10; j > 0; j--)
+                R[k].push_back(v++);
+        SimpleValidator* SV = (SimpleValidator*)0;
+        {
+            int n = 0;
+            for (int k=0; k < nr; k++)
+                n += (int)R[k].size();
+            Polygon P0(n);
+            for (int i=0; i < n; i++) {
+                P0.V[i].x = rng() % grid;
+                P0.V[i].y = rng() % grid;
+            }
+            std::vector<int> s0(1, 0);
+            for (int k=0; k < nr; k++)
+                s0.push_back(s0.back() + (int)R[k].size());
+            if (nr > 1)
+                P0.SetRings(&s0[0], nr);
+            SV = new SimpleValidator(P0);
+        }
+
+        for (int e=0; e < 100; e++) {
+            int k = rng() % nr;
+            int j = rng() % R[k].size();
+            int v = R[k][j];
+            double x = rng() % grid, y = rng() % grid;
+            switch (rng() % 3) {
+            case 0:
+                SV->Move(v, x, y);
+                break;
+            case 1:
+                R[k].insert(R[k].begin() + j + 1, SV->Insert(v, x, y));
+                break;
+            default:
+                if (SV->Delete(v))
+                    R[k].erase(R[k].begin() + j);
+                else
+                    CHECK(R[k].size() == 3, "Delete() refused, ring of %d",
+                          (int)R[k].size());
+                break;
+            }
+            V_polygon(*SV, R, P, start);
+            CHECK(SV->Vertices() == P->n, "SimpleValidator %d vertices, not %d",
+                  SV->Vertices(), P->n);
+            CHECK(SV->Simple() == simple_Polygon(*P, C),
+                  "SimpleValidator polygon %d edit %d", it, e);
+        }
+        delete SV;
+    }
+
+    // a big star with vertices dragged along their rays, which keeps it
+    // simple, and now and then one dragged off its ray, which need not
+    int n = 100000;
+    Polygon S(n);
+    gen_Star(S, 3);
+    SimpleValidator SV(S);
+    std::vector<std::vector<int> > R(1);
+    for (int i=0; i < n; i++)
+        R[0].push_back(i);
+    CHECK(SV.Simple(), "SimpleValidator star not simple");
+    std::uniform_real_distribution<double> u(-1, 1);
+    for (int e=0; e < 200; e++) {
+        int v = rng() % n;
+        Point p = SV.Vertex(v);
+        double fx = 1 + 0.05 * u(rng);     // along its ray: still simple
+        double fy = (e % 50 == 49) ? 1 + 0.05 * u(rng) : fx;
+        SV.Move(v, p.x * fx, p.y * fy);
+        if (e % 20 == 19) {
+            V_polygon(SV, R, P, start);
+            CHECK(SV.Simple() == simple_Polygon(*P, C),
+                  "SimpleValidator star edit %d", e);
+        }
+    }
+    delete P;
+}
+
+// the counts kept of each sweep: what was done, if built with SWEEP_STATS,
+// and nothing otherwise
+static void test_stats()
+{
+    std::vector<Polygon*> P;
+    for (int i=0; i < NGENERATORS; i++) {
+        P.push_back(new Polygon(1000));
+        Generators[i].make(*P.back(), 1);
+    }
+    P.push_back(new Polygon(3));               // answered without a sweep
+    for (int j=0; j < 3; j++) {
+        P.back()->V[j].x = j;
+        P.back()->V[j].y = j * j;
+    }
+    int np = (int)P.size();
+
+    SweepContext C;
+    std::vector<SweepStats> St(np);
+    for (int i=0; i < np; i++) {
+        C.stats = &St[i];
+        simple_Polygon(*P[i], C);
+    }
+    C.stats = (SweepStats*)0;
+    std::vector<SweepStats> Sb(np);
+    bool* S = new bool[np];
+    simple_Polygons(&P[0], np, S, 4, STATUS_AVL, &Sb[0]);
+    delete [] S;
+
+    SweepStats Total, Zero;
+    for (int i=0; i < np; i++) {
+        const SweepStats &s = St[i];
+        add_Stats(Total, s);
+#ifdef SWEEP_STATS
+        CHECK(s.calls == 1 && s.vertices == P[i]->n,
+              "stats %d: calls %lld vertices %lld", i,
+              (long long)s.calls, (long long)s.vertices);
+        if (s.quick)
+            CHECK(s.events == 0 && s.compares == 0 && s.peak == 0,
+                  "stats %d: a quick answer swept", i);
+        else
+            CHECK(s.events > 0 && s.compares > 0 && s.isLefts >= s.compares
+                  && s.insert_steps > 0 && s.peak > 0 && s.sort_ms >= 0
+                  && s.total_ms >= s.sort_ms + s.sweep_ms - 1e-3,
+                  "stats %d: events %lld compares %lld isLefts %lld peak %lld",
+                  i, (long long)s.events, (long long)s.compares,
+                  (long long)s.isLefts, (long long)s.peak);
+        CHECK(Sb[i].vertices == s.vertices && Sb[i].events == s.events
+              && Sb[i].compares == s.compares,
+              "stats %d: simple_Polygons() counted differently", i);
+#else
+        CHECK(memcmp(&s, &Zero, sizeof(s)) == 0
+              && memcmp(&Sb[i], &Zero, sizeof(s)) == 0,
+              "stats %d: counted without SWEEP_STATS", i);
+#endif
+    }
+#ifdef SWEEP_STATS
+    CHECK(Total.calls == np && St[np-1].quick == 1,
+          "stats: %lld calls, triangle quick %lld",
+          (long long)Total.calls, (long long)St[np-1].quick);
+#else
+    CHECK(Total.calls == 0, "stats: calls counted without SWEEP_STATS");
+#endif
+    for (int i=0; i < np; i++)
+        delete P[i];
+}
+
+// polygon of the n points xy[], in rings starting at R[] if nr > 1
+static Polygon* xy_Polygon( const double xy[][2], int n, const int* R=0,
+                            int nr=1 )
+{
+    Polygon* P = new Polygon(n);
+    for (int i=0; i < n; i++) {
+        P->V[i].x = xy[i][0];
+        P->V[i].y = xy[i][1];
+    }
+    if (nr > 1)
+        P->SetRings(R, nr);
+    return P;
+}
+
+// near-duplicate vertices merged, zero length edges dropped, and vertices
+// rounded to a grid, by CleanPolygon
+static void test_clean()
+{
+    // a closing vertex repeated, and one written twice a hair apart
+    static const double sq[7][2] = { {0,0}, {1,0}, {1,1e-13}, {1,1},
+                                     {0,1}, {0,1}, {0,0} };
+    Polygon* P = xy_Polygon(sq, 7);
+    CHECK(!simple_Polygon(*P), "clean: repeated vertices simple");
+    {
+        CleanPolygon Q(*P, 1e-9);
+        CHECK(Q.Poly().n == 4 && Q.Dropped() == 3 && Q.Merged() == 1
+              && Q.Collapsed() == 0,
+              "clean: square left %d, dropped %d, merged %d", Q.Poly().n,
+              Q.Dropped(), Q.Merged());
+        CHECK(simple_Polygon(Q.Poly()), "clean: square not simple");
+        static const int src[4] = { 0, 1, 3, 4 };
+        for (int j=0; j < 4 && j < Q.Poly().n; j++)
+            CHECK(Q.Source(j) == src[j], "clean: vertex %d from %d", j,
+                  Q.Source(j));
+    }
+    {
+        CleanPolygon Q(*P, 0);     // exact duplicates only
+        CHECK(Q.Poly().n == 5 && Q.Merged() == 0 && simple_Polygon(Q.Poly()),
+              "clean: tol 0 left %d", Q.Poly().n);
+    }
+    delete P;
+
+    // two vertices that were meant to be one, 1e-12 apart: they touch
+    // once merged
+    static const double pinch[6][2] = { {0,0}, {2,1}, {4,0}, {4,2},
+                                        {2,1+1e-12}, {0,2} };
+    P = xy_Polygon(pinch, 6);
+    CHECK(simple_Polygon(*P), "clean: pinch not simple before merging");
+    {
+        CleanPolygon Q(*P, 1e-9);
+        CHECK(Q.Poly().n == 6 && Q.Merged() == 1 && !simple_Polygon(Q.Poly()),
+              "clean: pinch simple after merging");
+    }
+    delete P;
+
+    // a hole touching its shell at a vertex, and a hole that collapses
+    // to a point
+    static const int R[4] = { 0, 4, 7, 11 };
+    static const double holes[11][2] = {
+        {0,0}, {10,0}, {10,10}, {0,10},
+        {0,1e-10}, {3,3}, {3,1},
+        {5,5}, {5,5+1e-12}, {5+1e-12,5}, {5,5} };
+    P = xy_Polygon(holes, 11, R, 3);
+    CHECK(simple_Polygon(*P) == false, "clean: holes simple before merging");
+    {
+        CleanPolygon Q(*P, 1e-9);
+        CHECK(Q.Poly().nr == 3 && Q.Poly().n == 11 && Q.Collapsed() == 1
+              && !simple_Polygon(Q.Poly()),
+              "clean: holes left %d vertices, %d collapsed", Q.Poly().n,
+              Q.Collapsed());
+    }
+    delete P;
+    static const double touch[7][2] = {
+        {0,0}, {10,0}, {10,10}, {0,10}, {5,1e-10}, {7,3}, {3,3} };
+    static const int R2[3] = { 0, 4, 7 };
+    P = xy_Polygon(touch, 7, R2, 2);
+    CHECK(simple_Polygon(*P), "clean: hole near its shell not simple");
+    {
+        CleanPolygon Q(*P, 1e-9, 0);
+        CHECK(simple_Polygon(Q.Poly()), "clean: hole moved onto its shell");
+        CleanPolygon G(*P, 0, 1.0);    // rounded onto it
+        CHECK(G.Poly().V[4].y == 0 && !simple_Polygon(G.Poly()),
+              "clean: hole not rounded onto its shell");
+    }
+    delete P;
+
+    // the generators' polygons are left as they are, and many random
+    // points a little off a few hundred give a few hundred
+    for (int i=0; i < NGENERATORS; i++) {
+        Polygon G(1000);
+        Generators[i].make(G, 1);
+        CleanPolygon Q(G, 1e-12);
+        bool same = Q.Poly().n == G.n;
+        for (int j=0; same && j < G.n; j++)
+            same = Q.Poly().V[j].x == G.V[j].x && Q.Poly().V[j].y == G.V[j].y;
+        CHECK(same && simple_Polygon(Q.Poly()) == simple_Polygon(G),
+              "clean: %s changed", Generators[i].name);
+    }
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<double> u(-1e-7, 1e-7);
+    Polygon N(100000);
+    for (int j=0; j < N.n; j++) {
+        int k = (j / 250) % 400;               // 250 copies of each in turn
+        N.V[j].x = (k % 20) + u(rng);
+        N.V[j].y = (k / 20) + u(rng);
+    }
+    CleanPolygon Q(N, 1e-6);
+    CHECK(Q.Poly().n == 400 && Q.Dropped() == N.n - 400,
+          "clean: %d random points left %d", N.n, Q.Poly().n);
+}
+
+// rect_Comb(): a rectilinear comb of k teeth, 4k+2 vertices, the teeth
+// pointing right from a spine at x=0, so half the vertices have x=0 and
+// half x=k; given from the top down if 'down'
+static void rect_Comb( Polygon &P, int k, bool down )
+{
+    int n = 0;
+    for (int i=0; i < k; i++) {
+        static const int Q[4][2] = { {0,0}, {1,0}, {1,1}, {0,1} };
+        for (int j=0; j < 4; j++) {
+            P.V[n].x = Q[j][0] * k;
+            P.V[n++].y = 2*i + Q[j][1];
+        }
+    }
+    P.V[n].x = -1;   P.V[n++].y = 2*k - 1;
+    P.V[n].x = -1;   P.V[n++].y = 0;
+    if (down)
+        std::reverse(P.V, P.V + n);
+}
+
+static double ms_Since( std::chrono::steady_clock::time_point t0 )
+{
+    return std::chrono::duration<double, std::milli>(
+               std::chrono::steady_clock::now() - t0).count();
+}
+
+// polygons with long runs of vertices at the same x, given in either
+// order, sorted in O(n log n): a rectilinear comb of 80k vertices takes
+// no longer than a star of as many, and took a hundred times longer when
+// each run was insertion sorted
+static double ms_Check( Polygon &P, bool &simple )
+{
+    std::vector<Crossing> X;
+    std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now();
+    simple = simple_Polygon(P);
+    simple = all_Crossings(P, X) == 0 && simple;
+    return ms_Since(t0);
+}
+
+static void test_sort()
+{
+    const int k = 20000;
+    Polygon P(4*k + 2);
+    bool simple;
+    Generators[0].make(P, 1);              // Star
+    double star = ms_Check(P, simple);
+    for (int down=0; down < 2; down++) {
+        rect_Comb(P, k, down != 0);
+        double ms = ms_Check(P, simple);
+        CHECK(simple, "comb down=%d: not simple", down);
+        CHECK(ms < 4 * star + 20, "comb down=%d: %.0f ms, star %.0f ms", down,
+              ms, star);
+    }
+}
+
+// parallel_simple_Polygon() gives simple_Polygon()'s answer exactly: on
+// tiny polygons with repeated vertices, and on big ones cut into slabs,
+// with a vertex repeated, moved onto another, or moved across, and on a
+// rectilinear comb, whose vertices are all on the slab boundaries
+static void test_parallel()
+{
+    std::mt19937 rng(606);
+    for (int it=0; it < 20000; it++) {
+        int n = 1 + rng() % 6;
+        Polygon P(n);
+        for (int j=0; j < n; j++) {
+            P.V[j].x = rng() % 3;
+            P.V[j].y = rng() % 3;
+        }
+        bool simple = simple_Polygon(P);
+        CHECK(parallel_simple_Polygon(P, 1) == simple &&
+              parallel_simple_Polygon(P, 3) == simple,
+              "parallel %d: %d vertices, simple=%d", it, n, simple);
+    }
+
+    const int n = 50002;           // 3 slabs, on 3 threads or more
+    Polygon P(n);
+    for (int g=0; g < 3; g++)
+        for (int v=0; v < 4; v++) {
+            if (g < 2)
+                Generators[g ? 2 : 0].make(P, 1);   // Star, Spiral
+            else
+                rect_Comb(P, (n - 2) / 4, false);
+            int j = rng() % (n - 1), k = rng() % n;
+            if (v == 1)
+                P.V[j+1] = P.V[j];
+            else if (v == 2)
+                P.V[j] = P.V[k];
+            else if (v == 3 && g == 2)
+                P.V[4*(j % ((n - 2) / 4)) + 2].y += 1;  // a tooth onto
+                                                        // the next
+            else if (v == 3)
+                P.V[j].x += 1e-3 * (P.V[k].x - P.V[j].x);
+            bool simple = simple_Polygon(P);
+            CHECK((v == 0) == simple || g < 2 || v == 2,
+                  "parallel: comb change %d simple=%d", v, simple);
+            CHECK(v != 0 || simple, "parallel: generator %d not simple", g);
+            for (int t=2; t <= 4; t++)
+                CHECK(parallel_simple_Polygon(P, t) == simple,
+                      "parallel: generator %d change %d, %d threads", g, v, t);
+        }
+}
+
+// a batch on 1 to 8 threads gives each polygon simple_Polygon()'s answer,
+// with every status tree and every engine: the generators at several sizes,
+// simple and made not simple, among many small polygons on a grid, so the
+// tasks are many and the threads that run out steal from the others
+static void test_batch()
+{
+    std::mt19937 rng(505);
+    std::vector<Polygon*> P;
+    for (int i=0; i < NGENERATORS; i++)
+        for (int n = 10; n <= 10000; n *= 10) {
+            for (int v=0; v < 2; v++) {
+                P.push_back(new Polygon(n));
+                Generators[i].make(*P.back(), 1);
+                if (v == 1) {                   // a vertex written twice
+                    int j = rng() % (n - 1);
+                    P.back()->V[j+1] = P.back()->V[j];
+                }
+            }
+        }
+    for (int it=0; it < 3000; it++) {
+        int n = 1 + rng() % 40;
+        P.push_back(new Polygon(n));
+        for (int j=0; j < n; j++) {
+            P.back()->V[j].x = rng() % 16;
+            P.back()->V[j].y = rng() % 16;
+        }
+    }
+    std::shuffle(P.begin(), P.end(), rng);
+    int np = (int)P.size();
+
+    std::vector<char> Ss(np);
+    for (int i=0; i < np; i++)
+        Ss[i] = simple_Polygon(*P[i]);
+    bool* S = new bool[np];
+    for (int t=1; t <= 8; t++)
+        for (int k=0; k < STATUS_KINDS + ENGINE_KINDS; k++) {
+            // the sweep in each status tree, then each other engine
+            StatusKind status = (k < STATUS_KINDS) ? (StatusKind)k : STATUS_AVL;
+            EngineKind engine = (k < STATUS_KINDS) ? ENGINE_SWEEP
+                                    : (EngineKind)(k - STATUS_KINDS + 1);
+            for (int i=0; i < np; i++)     // wrong until written
+                S[i] = !Ss[i];
+            simple_Polygons(&P[0], np, S, t, status, (SweepStats*)0, engine);
+            int wrong = 0;
+            for (int i=0; i < np; i++)
+                if (S[i] != (bool)Ss[i] && !wrong++)
+                    CHECK(false, "batch: %d threads, %s/%s: polygon %d "
+                          "(%d vertices) simple=%d", t, StatusName[status],
+                          EngineName[engine], i, P[i]->n, (int)Ss[i]);
+        }
+    simple_Polygons(&P[0], 0, S, 4);            // nothing to do
+    delete [] S;
+    for (int i=0; i < np; i++)
+        delete P[i];
+}
+
+// an SLP file written and mapped back: the same vertices and rings, and
+// the same answers.  It is left as test_polygons.slp in the build
+// directory for the sl_validate test, which expects 17 polygons, 4 of
+// them not simple.
+static void test_file()
+{
+    std::vector<Polygon*> P;
+    for (int i=0; i < NGENERATORS; i++)
+        for (int n = 10; n <= 1000; n *= 100) {
+            P.push_back(new Polygon(n));
+            Generators[i].make(*P.back(), 1);
+        }
+    // a square with a square hole, and with the hole poking out of it
+    static const int start[3] = { 0, 4, 8 };
+    static const double sq[2][8][2] = {
+        { {0,0}, {10,0}, {10,10}, {0,10}, {2,2}, {2,8}, {8,8}, {8,2} },
+        { {0,0}, {10,0}, {10,10}, {0,10}, {2,2}, {2,8}, {12,8}, {8,2} } };
+    for (int h=0; h < 2; h++) {
+        Polygon* Q = new Polygon(8);
+        for (int j=0; j < 8; j++) {
+            Q->V[j].x = sq[h][j][0];
+            Q->V[j].y = sq[h][j][1];
+        }
+        Q->SetRings(start, 2);
+        P.push_back(Q);
+    }
+    // a triangle with a zero length edge, 1, and no crossing edges
+    static const double tri[3][2] = { {0,0}, {1,1}, {1,1} };
+    P.push_back(new Polygon(3));
+    for (int j=0; j < 3; j++) {
+        P.back()->V[j].x = tri[j][0];
+        P.back()->V[j].y = tri[j][1];
+    }
+
+    std::string path = std::string(SL_TEST_DIR) + "/test_polygons.slp";
+    try {
+        write_Polygons(path.c_str(), &P[0], (int)P.size());
+        PolygonFile F(path.c_str());
+        CHECK(F.Count() == (int64_t)P.size(), "file has %lld polygons",
+              (long long)F.Count());
+        for (int64_t i=0; i < F.Count() && i < (int64_t)P.size(); i++) {
+            Polygon* Q = F.View(i);
+            bool same = Q->n == P[i]->n && Q->nr == P[i]->nr;
+            for (int k=0; same && k < Q->nr; k++)
+                same = Q->RingStart(k) == P[i]->RingStart(k) &&
+                       Q->RingEnd(k) == P[i]->RingEnd(k);
+            for (int j=0; same && j < Q->n; j++)
+                same = Q->Vertex(j).x == P[i]->V[j].x &&
+                       Q->Vertex(j).y == P[i]->V[j].y;
+            CHECK(same, "polygon %lld read back different", (long long)i);
+            CHECK(simple_Polygon(*Q) == simple_Polygon(*P[i]),
+                  "polygon %lld read back answers differently", (long long)i);
+            delete Q;
+        }
+    }
+    catch (std::exception &e) {
+        CHECK(false, "%s", e.what());
+    }
+
+    // a file cut short after its header is refused when it is opened
+    char head[32] = { 'S', 'L', 'P', '1', 8 };
+    head[8] = 1;                   // np, ns, nv = 1, 2, 3
+    head[16] = 2;
+    head[24] = 3;
+    std::string shrt = std::string(SL_TEST_DIR) + "/test_short.slp";
+    FILE* f = fopen(shrt.c_str(), "wb");
+    fwrite(head, 1, sizeof(head), f);
+    fclose(f);
+    bool refused = false;
+    try {
+        PolygonFile F(shrt.c_str());
+    }
+    catch (std::runtime_error &) {
+        refused = true;
+    }
+    CHECK(refused, "short file opened");
+    remove(shrt.c_str());
+
+    for (size_t i=0; i < P.size(); i++)
+        delete P[i];
+}
+
+int main()
+{
+    test_generators();
+    test_brute_force();
+    test_segments();
+    test_views();
+    test_engines();
+    test_exact();
+    test_kernel();
+    test_convex();
+    test_external();
+    test_validator();
+    test_stats();
+    test_clean();
+    test_file();
+    test_sort();
+    test_parallel();
+    test_batch();
+    if (failures)
+        printf("%d failures\n", failures);
+    else
+        printf("all passed\n");
+    return failures ? 1 : 0;
+}
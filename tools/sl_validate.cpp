@@ -0,0 +1,219 @@
+// sl_validate.cpp - Check every polygon of an SLP file (PolygonFile.h)
+//
+//     sl_validate [-t threads] [-s avl|rb|btree|auto] [-b bitmap] [-x crossings]
+//                 [-S stats] [-m tol] [-g grid] [-e sweep|brute|grid|rtree|auto]
+//                 file.slp
+//
+// The file is mapped, and its polygons swept where they lie, a chunk at
+// a time, on 'threads' threads (0, the default, => one per core).
+//     -b  write a bitmap, bit i (LSB first within each byte) set if
+//         polygon i is simple
+//     -x  write the crossing edge pairs of each polygon that is not, one
+//         "polygon e1 e2 x y" line each (see all_Crossings()), and its zero
+//         length edges, which make it NOT simple too, as "polygon e e x y"
+//     -s  the status tree to sweep with; auto times each on a sample
+//     -e  the engine to use (Engines.h); auto, the default, picks one for
+//         each polygon (choose_Engine())
+//     -m  merge the vertices within tol of each other and drop the zero
+//         length edges that leaves, first (CleanPolygon.h); crossings are
+//         still given by the file's edge numbers
+//     -g  round the vertices to multiples of grid, before merging
+//     -S  write the counts of each polygon's sweep, one "polygon name=value
+//         ..." line each (print_Stats()), then a "total" line; only if
+//         built with SWEEP_STATS (cmake -DSWEEPLINE_STATS=ON), and only
+//         the sweep is counted, so use -e sweep with it
+// Prints "<np> polygons, <k> not simple".  Exits 0 if all went well
+// (simple or not), 1 on bad arguments, and 2 if a file could not be read
+// or written.
+
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <exception>
+#include <vector>
+#include "simple_polygon.h"
+#include "PolygonFile.h"
+#include "SweepStats.h"
+#include "CleanPolygon.h"
+
+static const int CHUNK = 65536;    // polygon views made at a time
+static const int SAMPLE = 256;     // polygons fastest_Status() times
+
+static void usage()
+{
+    fprintf(stderr, "usage: sl_validate [-t threads] [-s avl|rb|btree|auto] "
+                    "[-b bitmap] [-x crossings] [-S stats] [-m tol] [-g grid] "
+                    "[-e sweep|brute|grid|rtree|auto] file.slp\n");
+}
+
+// closed(): close f, if open, and say if everything written to it got there
+static bool closed( FILE* f, const char* path )
+{
+    if (!f)
+        return true;
+    bool ok = !ferror(f);
+    if (fclose(f) != 0)
+        ok = false;
+    if (!ok)
+        perror(path);
+    return ok;
+}
+
+int main( int argc, char** argv )
+{
+    int         nthreads = 0;
+    const char* bitmap = (const char*)0;
+    const char* crossings = (const char*)0;
+    const char* stats = (const char*)0;
+    double      tol = 0, grid = 0;
+    const char* status = "auto";
+    const char* engine = "auto";
+    int         c;
+
+    while ((c = getopt(argc, argv, "t:s:b:x:S:m:g:e:")) != -1) {
+        switch (c) {
+        case 't': nthreads = atoi(optarg); break;
+        case 's': status = optarg;         break;
+        case 'b': bitmap = optarg;         break;
+        case 'x': crossings = optarg;      break;
+        case 'S': stats = optarg;          break;
+        case 'm': tol = atof(optarg);      break;
+        case 'g': grid = atof(optarg);     break;
+        case 'e': engine = optarg;         break;
+        default:  usage(); return 1;
+        }
+    }
+    static const char* Names[STATUS_KINDS + 1] = { "avl", "rb", "btree", "auto" };
+    int kind = 0;
+    while (kind <= STATUS_KINDS && strcmp(status, Names[kind]) != 0)
+        kind++;
+    static const char* Engines[ENGINE_KINDS + 1] = { "sweep", "brute", "grid",
+                                                     "rtree", "auto" };
+    int ekind = 0;
+    while (ekind <= ENGINE_KINDS && strcmp(engine, Engines[ekind]) != 0)
+        ekind++;
+    if (optind != argc - 1 || nthreads < 0 || kind > STATUS_KINDS
+        || ekind > ENGINE_KINDS
+        || !(tol >= 0) || !(grid >= 0)) {
+        usage();
+        return 1;
+    }
+#ifndef SWEEP_STATS
+    if (stats) {
+        fprintf(stderr, "sl_validate: -S needs a build with SWEEP_STATS\n");
+        return 1;
+    }
+#endif
+
+    FILE* fb = (FILE*)0;
+    FILE* fx = (FILE*)0;
+    FILE* fs = (FILE*)0;
+    try {
+        PolygonFile F(argv[optind]);
+        int64_t np = F.Count();
+
+        std::vector<Polygon*> P;
+        if (kind == STATUS_KINDS) {
+            for (int64_t i=0; i < np && i < SAMPLE; i++)
+                P.push_back(F.View(i));
+            kind = P.empty() ? STATUS_AVL
+                             : fastest_Status(&P[0], (int)P.size());
+            for (size_t i=0; i < P.size(); i++)
+                delete P[i];
+            P.clear();
+        }
+
+        if (bitmap && !(fb = fopen(bitmap, "wb"))) {
+            perror(bitmap);
+            return 2;
+        }
+        if (crossings && !(fx = fopen(crossings, "w"))) {
+            perror(crossings);
+            if (fb) fclose(fb);
+            return 2;
+        }
+        if (stats && !(fs = fopen(stats, "w"))) {
+            perror(stats);
+            if (fb) fclose(fb);
+            if (fx) fclose(fx);
+            return 2;
+        }
+
+        bool*    S = new bool[CHUNK];
+        std::vector<SweepStats> St(fs ? CHUNK : 0);
+        SweepStats Total;
+        unsigned char bits[CHUNK / 8];
+        int64_t  bad = 0;
+        std::vector<Crossing> X;
+        std::vector<Polygon*> Q;           // the polygons cleaned, with -m, -g
+        std::vector<CleanPolygon*> Cp;
+        for (int64_t i0=0; i0 < np; i0 += CHUNK) {
+            int m = (int)((np - i0 < CHUNK) ? np - i0 : CHUNK);
+            for (int i=0; i < m; i++)
+                P.push_back(F.View(i0 + i));
+            bool clean = tol > 0 || grid > 0;
+            for (int i=0; clean && i < m; i++) {
+                Cp.push_back(new CleanPolygon(*P[i], tol, grid));
+                Q.push_back(&Cp[i]->Poly());
+            }
+            simple_Polygons(clean ? &Q[0] : &P[0], m, S, nthreads, (StatusKind)kind,
+                            fs ? &St[0] : (SweepStats*)0, (EngineKind)ekind);
+            for (int i=0; fs && i < m; i++) {
+                fprintf(fs, "%lld ", (long long)(i0 + i));
+                print_Stats(fs, St[i]);
+                add_Stats(Total, St[i]);
+            }
+
+            memset(bits, 0, sizeof(bits));
+            for (int i=0; i < m; i++) {
+                if (S[i]) {
+                    bits[i >> 3] |= (unsigned char)(1 << (i & 7));
+                    continue;
+                }
+                bad++;
+                if (!fx)
+                    continue;
+                Polygon& Pi = clean ? *Q[i] : *P[i];
+                for (int j=0; j < Pi.n; j++) {
+                    Point a = Pi.Vertex(j), b = Pi.Vertex(Pi.Next(j));
+                    if (a.x == b.x && a.y == b.y) {
+                        int e = clean ? Cp[i]->Source(j) : j;
+                        fprintf(fx, "%lld %d %d %.17g %.17g\n", (long long)(i0 + i),
+                                e, e, a.x, a.y);
+                    }
+                }
+                all_Crossings(Pi, X);
+                for (size_t k=0; k < X.size(); k++) {
+                    int e1 = clean ? Cp[i]->Source(X[k].e1) : X[k].e1;
+                    int e2 = clean ? Cp[i]->Source(X[k].e2) : X[k].e2;
+                    fprintf(fx, "%lld %d %d %.17g %.17g\n", (long long)(i0 + i),
+                            e1, e2, X[k].P.x, X[k].P.y);
+                }
+            }
+            if (fb)
+                fwrite(bits, 1, (m + 7) / 8, fb);
+
+            for (int i=0; i < m; i++)
+                delete P[i];
+            for (size_t i=0; i < Cp.size(); i++)
+                delete Cp[i];
+            P.clear();
+            Q.clear();
+            Cp.clear();
+        }
+        delete [] S;
+        if (fs) {
+            fprintf(fs, "total ");
+            print_Stats(fs, Total);
+        }
+
+        if (!closed(fb, bitmap) | !closed(fx, crossings) | !closed(fs, stats))
+            return 2;
+        printf("%lld polygons, %lld not simple\n", (long long)np, (long long)bad);
+    }
+    catch (std::exception &e) {
+        fprintf(stderr, "sl_validate: %s\n", e.what());
+        return 2;
+    }
+    return 0;
+}